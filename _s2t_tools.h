@@ -1,20 +1,336 @@
 
 #include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <new>
 #include <utility>
 //#include <assert.h>
+#if __cplusplus>=202002L
+    #include <span>
+#endif
 
 // #include <string.h>  only for memcpy();
-// #include <new>       for "new"
+// #include <stdlib.h>  for malloc()/realloc()/free() used with trivially copyable types;
+// #include <stdint.h>  for uint32_t and other fixed-size integers (and uintptr_t used to align memory of CustomBumpArena);
+// #include <stddef.h>  for size_t and ptrdiff_t (difference_type of CustomVector);
+// #include <new>       for "new" (and aligned "operator new" with c++17)
 // #include <utility>   for "std::move()" and others functions
 // #include <assert.h>  for "assert()" only (you can not include this if you're not ussing "assert()" in [] operator);
+// #include <span>      (only with c++20) for "get_span()" of CustomVector;
+
+// memory of CustomVector with trivially copyable T (int,SDL_Rect and other types without constructors) is managed with malloc()/realloc()/free()
+//      so growing/shrinking can be done in place without copying elements when allocator allows it; glibc realloc() remaps pages with mremap() only
+//      for blocks above its mmap threshold, which grows up to 32 MB on 64-bit after the first such block is freed, so smaller blocks can be copied anyway;
+//      call "mallopt(M_MMAP_THRESHOLD,size)" from <malloc.h> at start of program if u need growth of blocks above "size" without copying;
+//      define "CUSTOMVECTOR_NO_REALLOC" before including this file to use always "operator new" and copying like for other types;
+#ifndef CUSTOMVECTOR_NO_REALLOC
+    #define CUSTOMVECTOR_USE_REALLOC
+#endif
+
+// define "CUSTOMVECTOR_LAZY_ALLOCATION" as 1 before including this file to make CustomVector allocate memory only at the first "push_back()"/"reserve()"
+//      (empty vector holds no memory like std::vector) and to make "clear()" keep allocated memory for the next elements;
+//      default (0) allocates "elements_count_start" elements in constructor and "clear()" shrinks memory to "elements_count_start";
+#ifndef CUSTOMVECTOR_LAZY_ALLOCATION
+    #define CUSTOMVECTOR_LAZY_ALLOCATION 0
+#endif
+
+// "if" for conditions known at compilation time (type traits of T); with c++17 it's "if constexpr" so unused branches aren't even compiled;
+#if __cplusplus>=201703L
+    #define CUSTOMVECTOR_IF_CONSTEXPR if constexpr
+#else
+    #define CUSTOMVECTOR_IF_CONSTEXPR if
+#endif
+
+// alignment guaranteed by malloc() (and by "operator new" without alignment argument); bigger alignments of CustomVector need aligned "operator new" from c++17;
+#define CUSTOMVECTOR_MALLOC_ALIGNMENT alignof(max_align_t)
+
+// says if objects of T can be moved to other place in memory with memcpy()/realloc() (without move constructor+destructor) when vector grows;
+//      by default it's true only for trivially copyable types; can be specialized for own classes that don't keep pointers to themselves, like:
+//          template <> struct CustomVectorTriviallyRelocatable<MyClass> {static const bool value = true;};
+template <typename T> struct CustomVectorTriviallyRelocatable
+{
+    static const bool value = std::is_trivially_copyable<T>::value;
+};
+
+// growth policies of CustomVector (second argument of template);
+//      "CustomVectorRuntimeGrowth" is default and keeps options in every object ("multiplication"/"elements_count_start" of constructor and
+//          "change_multiplication()"/"change_elements_count_start()");
+//      other policies are empty classes with options set at compilation time so they don't take memory of vector (arguments of constructor are ignored)
+//          and growing is calculated with constants;
+struct CustomVectorRuntimeGrowth
+{
+    size_t multiplication;
+    size_t elements_count_start;
+
+    void _set_growth(size_t elements_count_start,size_t multiplication) noexcept
+    {
+        if(elements_count_start==0) this->elements_count_start = 1;
+        else this->elements_count_start = elements_count_start;
+        if(multiplication<2) this->multiplication = 2;
+        else this->multiplication = multiplication;
+        return;
+    }
+
+    size_t _start_capacity() const noexcept
+    {
+        return this->elements_count_start;
+    }
+
+    size_t _grown_capacity(size_t max_elements) const noexcept
+    {
+        return max_elements*this->multiplication;
+    }
+
+    size_t _rounded_capacity(size_t elements) const noexcept
+    {
+        return elements;
+    }
+};
+
+// capacity grows "NUMERATOR/DENOMINATOR" times (like 3/2 == 1.5x) but always at least by 1 element;
+template <size_t ELEMENTS_COUNT_START = 4,size_t NUMERATOR = 2,size_t DENOMINATOR = 1> struct CustomVectorStaticGrowth
+{
+    static_assert(ELEMENTS_COUNT_START!=0,"CustomVectorStaticGrowth needs at least 1 starting element");
+    static_assert(DENOMINATOR!=0&&NUMERATOR>DENOMINATOR,"growth factor of CustomVectorStaticGrowth has to be bigger than 1");
+
+    void _set_growth(size_t,size_t) noexcept
+    {
+        return;
+    }
+
+    size_t _start_capacity() const noexcept
+    {
+        return ELEMENTS_COUNT_START;
+    }
+
+    size_t _grown_capacity(size_t max_elements) const noexcept
+    {
+        const size_t new_max_elements = max_elements*NUMERATOR/DENOMINATOR;
+        return (new_max_elements>max_elements) ? new_max_elements : max_elements+1;
+    }
+
+    size_t _rounded_capacity(size_t elements) const noexcept
+    {
+        return elements;
+    }
+};
+typedef CustomVectorStaticGrowth<4,3,2> CustomVectorGrowth1_5x;
+
+// capacity is always power of 2 (also after "reserve()"/bulk insertion) so it grows 2x;
+template <size_t ELEMENTS_COUNT_START = 4> struct CustomVectorPowerOf2Growth
+{
+    static_assert(ELEMENTS_COUNT_START!=0&&(ELEMENTS_COUNT_START&(ELEMENTS_COUNT_START-1))==0,"CustomVectorPowerOf2Growth needs power of 2 starting elements");
+
+    void _set_growth(size_t,size_t) noexcept
+    {
+        return;
+    }
+
+    size_t _start_capacity() const noexcept
+    {
+        return ELEMENTS_COUNT_START;
+    }
+
+    size_t _grown_capacity(size_t max_elements) const noexcept
+    {
+        return this->_rounded_capacity(max_elements+1);
+    }
+
+    size_t _rounded_capacity(size_t elements) const noexcept
+    {
+        size_t capacity = ELEMENTS_COUNT_START;
+        while(capacity<elements) capacity<<=1;
+        return capacity;
+    }
+};
+
+// interface of memory source for CustomVector; every CustomVector remembers allocator that was "current()" in the moment of its construction
+//      (NULL == global heap which is default) and gives its memory back only to this allocator;
+//      moved vector takes allocator together with memory of the other vector;
+//      containers rebuilt inside of other classes (like slots of "CustomIdMap" at rehashing) keep allocator of the object that is rebuilt;
+//      "current()" is set per thread with "CustomVectorAllocatorScope";
+class CustomVectorAllocator
+{
+public:
+
+    virtual void* allocate(size_t bytes,size_t alignment) = 0;
+    virtual void deallocate(void* data,size_t bytes) noexcept = 0;
+
+//  used only for trivially copyable types; "used_bytes" is count of bytes that have to be copied to the new memory;
+    virtual void* reallocate(void* data,size_t old_bytes,size_t new_bytes,size_t used_bytes,size_t alignment)
+    {
+        void* new_data = this->allocate(new_bytes,alignment);
+        if(used_bytes!=0) memcpy(new_data,data,used_bytes);
+        this->deallocate(data,old_bytes);
+        return new_data;
+    }
+
+    static CustomVectorAllocator*& current() noexcept
+    {
+        static thread_local CustomVectorAllocator* current_allocator = NULL;
+        return current_allocator;
+    }
+
+    virtual ~CustomVectorAllocator() {}
+};
+
+// sets "CustomVectorAllocator::current()" of this thread until end of the scope; used like:
+//      {
+//          CustomVectorAllocatorScope scope(&arena);
+//          cSDL_ButtonsManager* manager = new cSDL_ButtonsManager();    // every CustomVector made here takes memory from "arena";
+//      }
+class CustomVectorAllocatorScope
+{
+    CustomVectorAllocator* previous_allocator;
+
+public:
+
+    explicit CustomVectorAllocatorScope(CustomVectorAllocator* allocator) noexcept
+    {
+        this->previous_allocator = CustomVectorAllocator::current();
+        CustomVectorAllocator::current() = allocator;
+        return;
+    }
+
+    ~CustomVectorAllocatorScope() noexcept
+    {
+        CustomVectorAllocator::current() = this->previous_allocator;
+        return;
+    }
+
+    CustomVectorAllocatorScope(const CustomVectorAllocatorScope&) = delete;
+    CustomVectorAllocatorScope& operator=(const CustomVectorAllocatorScope&) = delete;
+};
+
+// bump allocator made for containers that are created and destroyed together (for example every CustomVector of one ui screen);
+//      "allocate()" only moves pointer inside of the actual block (new block is malloc'ed when it's full);
+//      "deallocate()" gives memory back only if it was the last allocation (so growing vector doesn't waste the block),
+//          everything else is freed at once with "reset()" or destructor of the arena;
+//      every CustomVector using the arena has to be destroyed before "reset()"/destructor of the arena;
+class CustomBumpArena : public CustomVectorAllocator
+{
+    struct Block
+    {
+        Block* previous;
+        size_t size;
+    };  // memory of the block is right after this header;
+
+    Block* last_block;
+    unsigned char* position;
+    unsigned char* end;
+    unsigned char* last_allocation;
+    size_t block_size;
+
+    void _add_block(size_t minimum_size)
+    {
+        size_t size = this->block_size;
+        if(minimum_size>size) size = minimum_size;
+
+        Block* block = (Block*)malloc(sizeof(Block)+size);
+        if(block==NULL) throw std::bad_alloc();
+        block->previous = this->last_block;
+        block->size = size;
+
+        this->last_block = block;
+        this->position = (unsigned char*)(block+1);
+        this->end = this->position+size;
+        return;
+    }
+
+    static unsigned char* _align(unsigned char* pointer,size_t alignment) noexcept
+    {
+        return (unsigned char*)(((uintptr_t)pointer+alignment-1)&~(uintptr_t)(alignment-1));
+    }
+
+public:
+
+    CustomBumpArena(size_t block_size = 64*1024)
+    {
+        this->last_block = NULL;
+        this->position = NULL;
+        this->end = NULL;
+        this->last_allocation = NULL;
+        this->block_size = block_size;
+        return;
+    }
+
+    void* allocate(size_t bytes,size_t alignment) override
+    {
+        unsigned char* data = _align(this->position,alignment);
+        if(this->last_block==NULL||data>this->end||bytes>(size_t)(this->end-data))   // aligned pointer can be already past the end of the block;
+        {
+            this->_add_block(bytes+alignment);
+            data = _align(this->position,alignment);
+        }
+        this->position = data+bytes;
+        this->last_allocation = data;
+        return data;
+    }
+
+    void deallocate(void* data,size_t bytes) noexcept override
+    {
+        (void)bytes;
+        if(data!=NULL&&data==this->last_allocation)
+        {
+            this->position = this->last_allocation;
+            this->last_allocation = NULL;
+        }
+        return;
+    }
+
+//  the last allocation grows in place while there's free space in the block;
+    void* reallocate(void* data,size_t old_bytes,size_t new_bytes,size_t used_bytes,size_t alignment) override
+    {
+        if(data!=NULL&&data==this->last_allocation&&new_bytes<=(size_t)(this->end-this->last_allocation))
+        {
+            this->position = this->last_allocation+new_bytes;
+            return data;
+        }
+        return CustomVectorAllocator::reallocate(data,old_bytes,new_bytes,used_bytes,alignment);
+    }
+
+//  frees everything allocated from the arena in one go; the first block is kept for the next use;
+    void reset() noexcept
+    {
+        if(this->last_block==NULL) return;
+        while(this->last_block->previous!=NULL)
+        {
+            Block* previous = this->last_block->previous;
+            free(this->last_block);
+            this->last_block = previous;
+        }
+        this->position = (unsigned char*)(this->last_block+1);
+        this->end = this->position+this->last_block->size;
+        this->last_allocation = NULL;
+        return;
+    }
+
+    ~CustomBumpArena() noexcept
+    {
+        while(this->last_block!=NULL)
+        {
+            Block* previous = this->last_block->previous;
+            free(this->last_block);
+            this->last_block = previous;
+        }
+        return;
+    }
+
+    CustomBumpArena(const CustomBumpArena&) = delete;
+    CustomBumpArena& operator=(const CustomBumpArena&) = delete;
+};
 // this class doesn't support types of T whose throws exceptions;
 // the class may contain bugs and should be tested even more strongly in every possible way;
-// if you have compilator error for these linse: if (std::is_trivially_copyable<T>::value) then off warnings or make these lines:
-//      if constexpr (std::is_trivially_copyable<T>::value) and add compilation option: -std=c++17; it will calculate these lines at compilation time;
-//      or just off warning by adding option to compilator clang/GNU: "-Wno-class-memaccess" or "/wd4996" in MSVC;
-// remember that if real_size_in_bytes() returns number divided by 16 (16-32-64 and so on) then u support technologies such as generating SSE2 instructions
-//      in optymalized assembly code which speeds up some functions in this class like "push_back()";
+// lines with type traits of T like: CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value) are "if constexpr" with compilation option -std=c++17
+//      (or newer) so they are calculated at compilation time; if you have compilator warnings for these lines with older standard then
+//      just off warning by adding option to compilator clang/GNU: "-Wno-class-memaccess" or "/wd4996" in MSVC;
+// second argument of template is growth policy ("CustomVectorRuntimeGrowth" by default; look at the policies above);
+// third argument of template is alignment of memory (alignof(T) by default); malloc()/"operator new" give only 16 bytes (alignof(max_align_t)) so for AVX (32)
+//      or whole cache lines (64) set it like: CustomVector<float,CustomVectorRuntimeGrowth,32> or shorter CustomAlignedVector<float,32>;
+//      alignment bigger than alignof(T) rounds memory up to multiple of alignment so vector-width loads of aligned blocks (also the last one after size())
+//          never go past memory of vector; these extra elements are counted in capacity;
+//      alignment bigger than 16 needs c++17 (aligned "operator new") and such memory isn't moved with realloc() 'cause it doesn't keep alignment;
 //
 // this vector has especially push_back faster propably for about ~2-6x (and can be far faster if u change multiplication/elements_count_start for cost of ram)
 //      comparing to std::vector and some other functions/instructions that are faster or comparablely fast to functions of std::vector;
@@ -56,8 +372,45 @@
 //  creating constructor is of course ~4x times slower than in std::vector and clear() is also slower than in std::vector
 //      but because my functions do different things so i'm not even going to compare them 'cause this is pointless;
 //  everyithing else should has basically the same speed as the original std::vector;
-template <typename T> class CustomVector
+//
+//  Benchmarks on modern hardware (the numbers above are old ones from Core Duo and without realloc()/allocators of this version):
+//      Test environment:
+//          Compilator: g++ (Debian) 12.2.0, -std=c++11, libstdc++ std::vector;
+//          Processor: virtual Intel Xeon (shared cloud machine, so results are noisy);
+//          CustomVector with default options (2 multiplication, 4 elements_count_start, realloc() on);
+//      Method (harness "benchmarks/customvector_bench.cpp" with <chrono>, no other libraries; build line is at the top of the file):
+//          every case is run once for warm-up and then 31 times; printed is median time and spread as interquartile range/median;
+//          both vectors are run in the same process with the same data; ratio is std::vector time/CustomVector time (>1 == CustomVector is faster);
+//          push_back: 100000 elements into empty vector (copy: named variable, move: std::move of it);
+//          reserve: 200x (constructor + reserve(10000) + 1 push_back); shrink_to_fit: copy of 100000 elements + push_back + shrink_to_fit();
+//          erase: 200x erase of 10 elements from index 10 of 10000 elements; copy assign: 100000 elements; move assign: 2000 moves;
+//          constructor: 100000 constructions of empty vector;
+//          types: "int" == unsigned int, "pod16" == struct of 4 unsigned ints, "string24" == struct with std::string of 24 chars (not trivially copyable);
+//      results below are ratios with -O2 | -O0 (median of 5 runs of the harness with -O2 and of 3 runs with -O0; spread inside of one run
+//          was mostly 5-25%; cases whose ratio changed by more than ~40% between runs are marked with "~"):
+//                          int             pod16           string24
+//      push_back copy      ~4.2 | 3.2      10.6 | 2.9      ~1.01 | 1.23
+//      push_back move      ~5.7 | 3.7      ~10.4 | 3.5     ~0.71 | 1.38
+//      reserve             0.68 | 1.64     0.71 | 1.60     0.78 | 1.38
+//      shrink_to_fit       3.1 | 2.9       3.2 | 3.1       ~2.5 | 3.4
+//      erase               1.00 | 1.31     1.04 | 1.05     ~1.15 | ~0.62
+//      copy assign         0.96 | 0.96     0.99 | 1.00     0.94 | 1.24
+//      move assign         0.10 | ~4.0     0.14 | 3.7      0.77 | 2.3
+//      constructor         0.13 | 0.90     0.13 | 0.86     0.13 | 0.88
+//  so push_back of trivially copyable types is still a lot faster (growing with realloc() doesn't touch new pages like copying to new memory does),
+//      shrink_to_fit is ~3x faster, but with -O2 constructor (it allocates memory) is ~7x slower and so is move assign test
+//          (it constructs new empty vector for every move; define "CUSTOMVECTOR_LAZY_ALLOCATION" 1 to have constructor without allocation);
+//      for class types like std::string most of functions are about the same as std::vector 'cause most of time is in constructors of elements
+//          (only shrink_to_fit is still ~2.5x faster);
+//      without optymalization (-O0) CustomVector wins or is even in most cases 'cause std::vector has a lot more levels of functions;
+//  if u want to compare it on your computer then run "benchmarks/customvector_bench.cpp" or measure it the same way (the same data in both vectors,
+//      warm-up, many runs and median) 'cause single run of push_back on fresh memory is mostly time of page faults;
+template <typename T,typename GrowthPolicy = CustomVectorRuntimeGrowth,size_t ALIGNMENT = alignof(T)> class CustomVector : private GrowthPolicy   // empty policy doesn't take memory (empty base optymalization);
 {
+    static_assert(ALIGNMENT>=alignof(T)&&(ALIGNMENT&(ALIGNMENT-1))==0,"alignment of CustomVector has to be power of 2 and at least alignof(T)");
+#if !defined(__cpp_aligned_new)
+    static_assert(ALIGNMENT<=CUSTOMVECTOR_MALLOC_ALIGNMENT,"alignment of CustomVector bigger than alignof(max_align_t) needs c++17 (aligned operator new)");
+#endif
 
 #if defined(__clang__)
   #define PUSH_WARNING_IGNORE_Wclass_memaaccess() \
@@ -86,73 +439,211 @@ template <typename T> class CustomVector
     size_t element_count;
     size_t size_of_objects;
     size_t max_elements;
-    size_t multiplication;
-    size_t elements_count_start;
+    CustomVectorAllocator* allocator;   // NULL == global heap;
 
-public:
+//  every memory of the class is allocated/freed only with these functions; "bytes" of "_deallocate()" has to be the same as in "_allocate()";
+    T* _allocate(size_t bytes) const
+    {
+        if(bytes==0) return NULL;
+        if(this->allocator!=NULL) return (T*)this->allocator->allocate(bytes,ALIGNMENT);
+#if defined(__cpp_aligned_new)
+        CUSTOMVECTOR_IF_CONSTEXPR(ALIGNMENT>CUSTOMVECTOR_MALLOC_ALIGNMENT)
+        {
+            return (T*)operator new(bytes,std::align_val_t(ALIGNMENT));
+        }
+#endif
+#if defined(CUSTOMVECTOR_USE_REALLOC)
+        CUSTOMVECTOR_IF_CONSTEXPR(CustomVectorTriviallyRelocatable<T>::value)
+        {
+            void* data = malloc(bytes);
+            if(data==NULL&&bytes!=0) throw std::bad_alloc();
+            return (T*)data;
+        }
+#endif
+        return (T*)operator new(bytes);
+    }
 
-    CustomVector(size_t elements_count_start = 4,size_t multiplication = 2)       //  multiplication: higher value == better optimalization for "push_back" function but higher usage of ram;
+    void _deallocate(T* data,size_t bytes) const noexcept
     {
-        if(elements_count_start==0) this->elements_count_start = 1;
-        else this->elements_count_start = elements_count_start;
-        if(multiplication<2) this->multiplication = 2;
-        else this->multiplication = multiplication;
+        if(data==NULL) return;
+        if(this->allocator!=NULL)
+        {
+            this->allocator->deallocate(data,bytes);
+            return;
+        }
+#if defined(__cpp_aligned_new)
+        CUSTOMVECTOR_IF_CONSTEXPR(ALIGNMENT>CUSTOMVECTOR_MALLOC_ALIGNMENT)
+        {
+            operator delete(data,std::align_val_t(ALIGNMENT));
+            return;
+        }
+#endif
+#if defined(CUSTOMVECTOR_USE_REALLOC)
+        CUSTOMVECTOR_IF_CONSTEXPR(CustomVectorTriviallyRelocatable<T>::value)
+        {
+            free(data);
+            return;
+        }
+#endif
+        (void)bytes;
+        operator delete(data);
+        return;
+    }
 
-        this->main_data = (T*)operator new(sizeof(T)*this->elements_count_start);
-        this->element_count = 0;
-        this->size_of_objects = sizeof(T)*this->elements_count_start;
-        this->max_elements = this->elements_count_start;
+//  bytes of memory for "elements" elements; with alignment bigger than alignof(T) it's rounded up to multiple of alignment
+//      so the last vector-width load of aligned block doesn't go past allocated memory;
+    static size_t _bytes_for_elements(size_t elements)
+    {
+        const size_t bytes = sizeof(T)*elements;
+        if(ALIGNMENT<=alignof(T)) return bytes;
+        return (bytes+(ALIGNMENT-1))&~(ALIGNMENT-1);
+    }
+
+//  capacity after growing of full vector; vector without memory (lazy or moved) starts from "elements_count_start";
+    size_t _next_capacity() const
+    {
+        if(this->max_elements==0) return this->_start_capacity();
+        return this->_grown_capacity(this->max_elements);
+    }
+
+//  makes place for "count" more elements with at most one reallocation (at least normal growth of "push_back()");
+    void _reserve_more(size_t count)
+    {
+        const size_t needed_elements = this->element_count+count;
+        if(needed_elements<=this->max_elements) return;
+
+        size_t new_max_elements = this->_next_capacity();
+        if(new_max_elements<needed_elements) new_max_elements = this->_rounded_capacity(needed_elements);
+        this->_reallocate(new_max_elements);
         return;
     }
 
-// clear() deallocate memory and shrinks it to the default size of the CustomVector;
-    void clear() noexcept
+//  moves elements to memory for "new_max_elements" elements; trivially relocatable elements are moved by realloc() (in place if it's possible);
+    void _reallocate(size_t new_max_elements)
     {
-        if(this->main_data!=NULL)
+        const size_t new_size_of_objects = _bytes_for_elements(new_max_elements);
+        new_max_elements = new_size_of_objects/sizeof(T);   // padding of alignment is also usable capacity;
+        T* copy_data;
+
+        CUSTOMVECTOR_IF_CONSTEXPR(CustomVectorTriviallyRelocatable<T>::value)
         {
-            if(!std::is_trivially_copyable<T>::value) // optymalization for variables like int (not classes with constructors);
+            bool reallocated = 0;
+            if(this->allocator!=NULL)
             {
-                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();  // even if 'T' isn't class then there's is no problem; compilator will allow this and
-                                                                                                //  do nothing about it; compilator just skips it in that case;
+                copy_data = (T*)this->allocator->reallocate(this->main_data,this->size_of_objects,new_size_of_objects,sizeof(T)*this->element_count,ALIGNMENT);
+                reallocated = 1;
+            }
+#if defined(CUSTOMVECTOR_USE_REALLOC)
+            else if(ALIGNMENT<=CUSTOMVECTOR_MALLOC_ALIGNMENT)  // realloc() gives only alignment of malloc();
+            {
+                PUSH_WARNING_IGNORE_Wclass_memaaccess();
+                copy_data = (T*)realloc((void*)this->main_data,new_size_of_objects);
+                POP_WARNING();
+                if(copy_data==NULL&&new_size_of_objects!=0) throw std::bad_alloc();
+                reallocated = 1;
+            }
+#endif
+            if(reallocated==1)
+            {
+                this->main_data = copy_data;
+                this->size_of_objects = new_size_of_objects;
+                this->max_elements = new_max_elements;
+                return;
             }
+        }
 
-            operator delete(this->main_data);       // "operator delete" and "delete" are 2 different things; "operator delete" doesn't run destructor;
+        copy_data = this->_allocate(new_size_of_objects);
+        CUSTOMVECTOR_IF_CONSTEXPR(CustomVectorTriviallyRelocatable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            if(this->element_count!=0) memcpy(copy_data,this->main_data,sizeof(T)*this->element_count);
+            POP_WARNING();
+        }
+        else
+        {
+            for (size_t i = 0; i!=this->element_count; i++)
+            {
+                new (&copy_data[i]) T(std::move(this->main_data[i]));
+                this->main_data[i].~T();
+            }
         }
+        this->_deallocate(this->main_data,this->size_of_objects);
+
+        this->main_data = copy_data;
+        this->size_of_objects = new_size_of_objects;
+        this->max_elements = new_max_elements;
+        return;
+    }
+
+public:
 
+// types used by std algorithms and containers; iterators are plain pointers so CustomVector is contiguous range (std::sort,std::execution::par,range-for etc.);
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    CustomVector(size_t elements_count_start = 4,size_t multiplication = 2)       //  multiplication: higher value == better optimalization for "push_back" function but higher usage of ram;
+    {                                                                               //      (both are ignored by static growth policies);
+        this->_set_growth(elements_count_start,multiplication);
+        this->allocator = CustomVectorAllocator::current();
         this->element_count = 0;
-        this->size_of_objects = sizeof(T)*this->elements_count_start;
-        this->main_data = (T*)operator new(sizeof(T)*this->elements_count_start);
-        this->max_elements = this->elements_count_start;
+
+        if(CUSTOMVECTOR_LAZY_ALLOCATION)
+        {
+            this->main_data = NULL;
+            this->size_of_objects = 0;
+            this->max_elements = 0;
+            return;
+        }
+
+        this->size_of_objects = _bytes_for_elements(this->_start_capacity());
+        this->max_elements = this->size_of_objects/sizeof(T);
+        this->main_data = this->_allocate(this->size_of_objects);
         return;
     }
 
-    void push_back(const T& variable) noexcept
+// clear() deallocate memory and shrinks it to the default size of the CustomVector;
+//      with "CUSTOMVECTOR_LAZY_ALLOCATION" it only destroys elements and keeps memory (use "shrink_to_fit()" to free it);
+    void clear() noexcept
     {
-        if(this->element_count==this->max_elements)
+        if(CUSTOMVECTOR_LAZY_ALLOCATION)
         {
-            this->size_of_objects = sizeof(T)*this->max_elements*this->multiplication;
-
-            T* copy_data = (T*)operator new(this->size_of_objects);
-            if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
             {
-                PUSH_WARNING_IGNORE_Wclass_memaaccess();
-                memcpy(copy_data,this->main_data,sizeof(T)*this->element_count);
-                POP_WARNING();
+                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
             }
-            else
+            this->element_count = 0;
+            return;
+        }
+
+        if(this->main_data!=NULL)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value) // optymalization for variables like int (not classes with constructors);
             {
-                for (size_t i = 0; i!=element_count; i++)
-                {
-                    new (&copy_data[i]) T(std::move(this->main_data[i]));
-                    this->main_data[i].~T();
-                }
+                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();  // even if 'T' isn't class then there's is no problem; compilator will allow this and
+                                                                                                //  do nothing about it; compilator just skips it in that case;
             }
-            operator delete(this->main_data);
 
-            this->main_data = copy_data;
-            this->max_elements = this->max_elements*this->multiplication;
+            this->_deallocate(this->main_data,this->size_of_objects);       // it doesn't run destructor (like "operator delete");
         }
-        if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+
+        this->element_count = 0;
+        this->size_of_objects = _bytes_for_elements(this->_start_capacity());
+        this->max_elements = this->size_of_objects/sizeof(T);
+        this->main_data = this->_allocate(this->size_of_objects);
+        return;
+    }
+
+    void push_back(const T& variable) noexcept
+    {
+        if(this->element_count==this->max_elements) this->_reallocate(this->_next_capacity());
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
         {
             this->main_data[this->element_count] = variable;
         }
@@ -163,36 +654,894 @@ public:
 
     void push_back(T&& variable) noexcept
     {
-        if(this->element_count==this->max_elements)
+        if(this->element_count==this->max_elements) this->_reallocate(this->_next_capacity());
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
         {
-            this->size_of_objects = sizeof(T)*this->max_elements*this->multiplication;
+            this->main_data[this->element_count] = variable;
+        }
+        else new (&this->main_data[this->element_count]) T(std::move(variable));
+        this->element_count++;
+        return;
+    }
 
-            T* copy_data = (T*)operator new(this->size_of_objects);
-            if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
-            {
-                PUSH_WARNING_IGNORE_Wclass_memaaccess();
-                memcpy(copy_data,this->main_data,sizeof(T)*this->element_count);
-                POP_WARNING();
-            }
-            else
-            {
-                for (size_t i = 0; i!=element_count; i++)
-                {
-                    new (&copy_data[i]) T(std::move(this->main_data[i]));
-                    this->main_data[i].~T();
-                }
-            }
-            operator delete(this->main_data);
+// constructs element at the end of vector from arguments of constructor of T (without temporary object);
+    template <typename... Args> void emplace_back(Args&&... arguments) noexcept
+    {
+        if(this->element_count==this->max_elements) this->_reallocate(this->_next_capacity());
+        new (&this->main_data[this->element_count]) T(std::forward<Args>(arguments)...);
+        this->element_count++;
+        return;
+    }
+
+// copies "count" elements to the end of vector with one check of memory (and one memcpy for trivially copyable types);
+//      "elements" can't point to memory of this vector;
+    void append(const T* elements,size_t count) noexcept
+    {
+        if(count==0) return;
+        this->_reserve_more(count);
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memcpy(&this->main_data[this->element_count],elements,sizeof(T)*count);
+            POP_WARNING();
+        }
+        else
+        {
+            for(size_t i = 0; i!=count; i++) new (&this->main_data[this->element_count+i]) T(elements[i]);
+        }
+        this->element_count+=count;
+        return;
+    }
+
+    void pop_back() noexcept
+    {
+        if(this->element_count!=0)
+        {
+            this->element_count--;
+            this->main_data[this->element_count].~T();
+        }
+        return;
+    }
+
+    void erase(size_t first,size_t last) noexcept
+    {
+        if(this->element_count==0) return;
+        if(last>=this->element_count) last = this->element_count-1;
+        if(first>last) return;
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors); one memmove of the tail;
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memmove(&this->main_data[first],&this->main_data[last+1],sizeof(T)*(this->element_count-last-1));
+            POP_WARNING();
+        }
+        else
+        {
+            for(size_t i = first; i<=last; i++) this->main_data[i].~T();
+
+            for(size_t i = last+1,j = first; i<this->element_count; i++,j++)
+            {
+                new (&this->main_data[j]) T(std::move(this->main_data[i]));
+                this->main_data[i].~T();
+            }
+        }
+
+        this->element_count-=(last-first)+1;
+
+        return;
+    }
+
+// removes element by moving the last element in its place; O(1) but order of elements isn't kept;
+    void erase_unordered(size_t index) noexcept
+    {
+        if(index>=this->element_count) return;
+        this->element_count--;
+        if(index==this->element_count)
+        {
+            this->main_data[index].~T();
+            return;
+        }
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            this->main_data[index] = this->main_data[this->element_count];
+        }
+        else
+        {
+            this->main_data[index].~T();
+            new (&this->main_data[index]) T(std::move(this->main_data[this->element_count]));
+            this->main_data[this->element_count].~T();
+        }
+        return;
+    }
+
+// removes every element for which "predicate(element)" returns true in one pass (order of the rest is kept); returns count of removed elements;
+    template <typename Predicate> size_t erase_if(Predicate predicate)
+    {
+        size_t new_size = 0;
+        for(size_t i = 0; i!=this->element_count; i++)
+        {
+            if(predicate(this->main_data[i]))
+            {
+                this->main_data[i].~T();
+                continue;
+            }
+            if(i!=new_size)
+            {
+                CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+                {
+                    this->main_data[new_size] = this->main_data[i];
+                }
+                else
+                {
+                    new (&this->main_data[new_size]) T(std::move(this->main_data[i]));
+                    this->main_data[i].~T();
+                }
+            }
+            new_size++;
+        }
+
+        const size_t removed_elements = this->element_count-new_size;
+        this->element_count = new_size;
+        return removed_elements;
+    }
+
+// inserts "count" elements before element at "position" (or at the end if "position" is bigger than size());
+//      "elements" can't point to memory of this vector;
+    void insert(size_t position,const T* elements,size_t count) noexcept
+    {
+        if(count==0) return;
+        if(position>this->element_count) position = this->element_count;
+        this->_reserve_more(count);
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memmove(&this->main_data[position+count],&this->main_data[position],sizeof(T)*(this->element_count-position));
+            memcpy(&this->main_data[position],elements,sizeof(T)*count);
+            POP_WARNING();
+        }
+        else
+        {
+            for(size_t i = this->element_count; i!=position; i--)
+            {
+                new (&this->main_data[i-1+count]) T(std::move(this->main_data[i-1]));
+                this->main_data[i-1].~T();
+            }
+            for(size_t i = 0; i!=count; i++) new (&this->main_data[position+i]) T(elements[i]);
+        }
+        this->element_count+=count;
+        return;
+    }
+
+    void insert(size_t position,const T& variable) noexcept
+    {
+        T copy_variable(variable);  // "variable" can be element of this vector;
+        this->insert(position,std::move(copy_variable));
+        return;
+    }
+
+    void insert(size_t position,T&& variable) noexcept
+    {
+        if(position>this->element_count) position = this->element_count;
+        this->_reserve_more(1);
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memmove(&this->main_data[position+1],&this->main_data[position],sizeof(T)*(this->element_count-position));
+            POP_WARNING();
+        }
+        else
+        {
+            for(size_t i = this->element_count; i!=position; i--)
+            {
+                new (&this->main_data[i]) T(std::move(this->main_data[i-1]));
+                this->main_data[i-1].~T();
+            }
+        }
+        new (&this->main_data[position]) T(std::move(variable));
+        this->element_count++;
+        return;
+    }
+
+    void reserve(size_t elements) noexcept
+    {
+        if (elements==0) elements = 1;
+        if(elements<=this->max_elements) return;
+
+        this->_reallocate(this->_rounded_capacity(elements));
+        return;
+    }
+
+// changes size of vector; new elements are copies of "variable"; removed elements are destroyed;
+    void resize(size_t new_size,const T& variable) noexcept
+    {
+        if(new_size<=this->element_count)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for(size_t i = new_size; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->element_count = new_size;
+            return;
+        }
+
+        T copy_variable(variable);  // "variable" can be element of this vector;
+        this->_reserve_more(new_size-this->element_count);
+        for(size_t i = this->element_count; i!=new_size; i++) new (&this->main_data[i]) T(copy_variable);
+        this->element_count = new_size;
+        return;
+    }
+
+// new elements are value-initialized (0 for int and other simple types);
+    void resize(size_t new_size) noexcept
+    {
+        if(new_size<=this->element_count)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for(size_t i = new_size; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->element_count = new_size;
+            return;
+        }
+
+        this->_reserve_more(new_size-this->element_count);
+        for(size_t i = this->element_count; i!=new_size; i++) new (&this->main_data[i]) T();
+        this->element_count = new_size;
+        return;
+    }
+
+// changes size of vector without initializing new elements (they have to be written before reading); only for trivially copyable types;
+    void resize_uninitialized(size_t new_size) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value,"resize_uninitialized() needs trivially copyable type");
+        if(new_size>this->element_count) this->_reserve_more(new_size-this->element_count);
+        this->element_count = new_size;
+        return;
+    }
+
+// if "element_count" is 0,then function forces minimum 1 element to be allocated in this class;
+//      (with "CUSTOMVECTOR_LAZY_ALLOCATION" empty vector frees all of its memory instead);
+    void shrink_to_fit() noexcept
+    {
+        if(this->element_count==this->max_elements||_bytes_for_elements(this->element_count)==this->size_of_objects) return;
+
+        size_t forced_miminum_1_element_allocate = 0;
+        if(this->element_count==0)
+        {
+            if(CUSTOMVECTOR_LAZY_ALLOCATION)
+            {
+                this->_deallocate(this->main_data,this->size_of_objects);
+                this->main_data = NULL;
+                this->size_of_objects = 0;
+                this->max_elements = 0;
+                return;
+            }
+            forced_miminum_1_element_allocate = 1;
+        }
+
+        this->_reallocate(this->element_count+forced_miminum_1_element_allocate);
+
+        return;
+    }
+
+// changes multiplication of growing array when using function "push_back()"; (only for "CustomVectorRuntimeGrowth");
+    void change_multiplication(size_t new_multiplication)
+    {
+        if(new_multiplication<2) this->multiplication = 2;
+        else this->multiplication = new_multiplication;
+        return;
+    }
+
+// changes starting reserve size for elements; used by function "clear()":
+    void change_elements_count_start(size_t new_elements_count_start)
+    {
+        if(new_elements_count_start==0) this->elements_count_start = 1;
+        else this->elements_count_start = new_elements_count_start;
+        return;
+    }
+
+    size_t size() const
+    {
+        return this->element_count;
+    }
+
+    size_t real_size_in_bytes() const
+    {
+        return this->size_of_objects;
+    }
+
+    size_t size_of_elements_in_bytes() const
+    {
+        return this->element_count*sizeof(T);
+    }
+
+// returns allocator used by this vector (NULL == global heap);
+    CustomVectorAllocator* get_allocator() const
+    {
+        return this->allocator;
+    }
+
+    bool empty() const
+    {
+        return 1 ? this->element_count == 0 : 0;
+    }
+
+// pointer to the first element; valid until next function that changes size/capacity of vector (like "push_back()");
+    T* data()
+    {
+        return this->main_data;
+    }
+
+    const T* data() const
+    {
+        return this->main_data;
+    }
+
+    T* begin()
+    {
+        return this->main_data;
+    }
+
+    const T* begin() const
+    {
+        return this->main_data;
+    }
+
+    T* end()
+    {
+        return this->main_data+this->element_count;
+    }
+
+    const T* end() const
+    {
+        return this->main_data+this->element_count;
+    }
+
+    const T* cbegin() const
+    {
+        return this->main_data;
+    }
+
+    const T* cend() const
+    {
+        return this->main_data+this->element_count;
+    }
+
+#if __cplusplus>=202002L
+// view of elements without copying; has the same lifetime as "data()";
+    std::span<T> get_span()
+    {
+        return std::span<T>(this->main_data,this->element_count);
+    }
+
+    std::span<const T> get_span() const
+    {
+        return std::span<const T>(this->main_data,this->element_count);
+    }
+#endif
+
+    const T& operator[](const size_t iterator) const
+    {
+        //assert(iterator<this->element_count);           // can be uncommented in debugging version of the program but performance will be lower;
+        return this->main_data[iterator];
+    }
+
+    T& operator[](const size_t iterator)
+    {
+        //assert(iterator<this->element_count);           // can be uncommented in debugging version of the program but performance will be lower;
+        return this->main_data[iterator];
+    }
+
+
+    ~CustomVector() noexcept
+    {
+        if(this->main_data!=NULL)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->_deallocate(this->main_data,this->size_of_objects);
+            this->main_data = NULL;
+        }
+        return;
+    }
+
+//  implementation for "rule of the five" needed 'cause of manual memory management existing in class (new/malloc);
+//------------------------------------------------------------------------------------------------------------------------------
+
+//  copying constructor; used like:
+//      Class object0 = object1;
+//      Class object0 = return_object();
+//          [inside return_object]:
+//          return object2;
+    CustomVector(const CustomVector& other) : GrowthPolicy(other)
+    {
+        this->element_count = other.element_count;
+        this->max_elements = other.max_elements;
+        this->size_of_objects = other.size_of_objects;
+        this->allocator = CustomVectorAllocator::current();     // copy is a new container so it takes memory like constructor;
+        this->main_data = this->_allocate(this->size_of_objects);
+
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            if(this->element_count!=0) memcpy(this->main_data,other.main_data,sizeof(T)*this->element_count);
+            POP_WARNING();
+        }
+        else
+        {
+            for (size_t i = 0; i!=this->element_count; i++) new (&this->main_data[i]) T(other.main_data[i]);
+        }
+
+        return;
+    }
+
+//  copying operator; used like:
+//      object0 = object1;
+//      object0 = return_object();
+//          [inside return_object]:
+//          return object2;
+    CustomVector& operator=(const CustomVector& other)
+    {
+        if (this==&other) return *this;   // check if you're using operator '=' with the same object;
+
+        if(other.element_count>this->max_elements)  //  optymalization;
+        {
+            if(this->main_data!=NULL)
+            {
+                CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+                {
+                    for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
+                }
+                this->_deallocate(this->main_data,this->size_of_objects);
+            }
+
+            // this->multiplication = other.multiplication;             // i want multiplication to be set as original has been setted;
+            //this->elements_count_start = other.elements_count_start;  // i want elements_count_start to be set as original has been setted;
+            this->element_count = other.element_count;
+            this->max_elements = other.max_elements;
+            this->size_of_objects = other.size_of_objects;
+            this->main_data = this->_allocate(this->size_of_objects);
+
+            CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)
+            {
+                PUSH_WARNING_IGNORE_Wclass_memaaccess();
+                memcpy(this->main_data,other.main_data,sizeof(T)*this->element_count);
+                POP_WARNING();
+            }
+            else
+            {
+                for (size_t i = 0; i!=this->element_count; i++) new (&this->main_data[i]) T(other.main_data[i]);
+            }
+
+        }
+        else    // main_data is large enough;
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for(size_t i = other.element_count; i<this->element_count; i++) this->main_data[i].~T();
+
+                for(size_t i = 0; i!=other.element_count; i++)
+                {
+                    if (i<this->element_count) this->main_data[i] = other.main_data[i];
+                    else new (&this->main_data[i]) T(other.main_data[i]);
+                }
+            }
+            else
+            {
+                PUSH_WARNING_IGNORE_Wclass_memaaccess();
+                if(other.element_count!=0) memcpy(this->main_data,other.main_data,sizeof(T)*other.element_count);
+                POP_WARNING();
+            }
+
+            this->element_count = other.element_count;
+        }
+
+        return *this;
+    }
+
+//  moving constructor; used like:
+//      Class object0 = Class();
+//      Class object0 = std::move(object1);
+//      Class object0 = return_object();
+//          [inside return_object]:
+//          return Class();
+    CustomVector(CustomVector&& other) noexcept : GrowthPolicy(other)  // noexcept is important for new c++ gadgets to inform that function doesn't throw exception
+    {                                                                      //     so function that doesn't support exception can run this function except copying function;
+        this->main_data = other.main_data;
+        this->element_count = other.element_count;
+        this->size_of_objects = other.size_of_objects;
+        this->max_elements = other.max_elements;
+        this->allocator = other.allocator;
+
+        other.main_data = NULL;
+        other.element_count = 0;
+        other.size_of_objects = 0;
+        other.max_elements = 0;
+
+        return;
+    }
+
+//  moving operator; used like:
+//      object0 = Class();
+//      object0 = std::move(object1);
+//      object0 = return_object();
+//          [inside return_object]:
+//          return Class();
+    CustomVector& operator=(CustomVector&& other) noexcept // noexcept is important for new c++ gadgets to inform that function doesn't throw exception
+    {                                                          //     so function that doesn't support exception can run this function except copying function;
+        if (this==&other) return *this;     // check if you're using operator '=' with the same object;
+
+        if (this->main_data!=NULL)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->_deallocate(this->main_data,this->size_of_objects);
+        }
+
+        this->main_data = other.main_data;
+        this->element_count = other.element_count;
+        this->size_of_objects = other.size_of_objects;
+        this->max_elements = other.max_elements;
+        //this->multiplication = other.multiplication;
+        //this->elements_count_start = other.elements_count_start;
+        this->allocator = other.allocator;      // memory has to be freed by allocator which allocated it;
+
+        other.main_data = NULL;
+        other.element_count = 0;
+        other.size_of_objects = 0;
+        other.max_elements = 0;
+
+        return *this;
+    }
+//------------------------------------------------------------------------------------------------------------------------------
+
+};
+
+// CustomVector with default growth and memory aligned to "ALIGNMENT" bytes (for SIMD loads like AVX: CustomAlignedVector<float,32>);
+template <typename T,size_t ALIGNMENT> using CustomAlignedVector = CustomVector<T,CustomVectorRuntimeGrowth,ALIGNMENT>;
+
+
+// needs class "CustomVector";
+//      hash map with open addressing (linear probing) made for mapping unical id to index of vector; both key and value are uint32_t;
+//      key 0xFFFFFFFF is reserved by the map and can't be used; "find()" returns 0xFFFFFFFF if there's no key;
+//      every function has O(1) average cost except rare rehashing at "insert()";
+class CustomIdMap
+{
+    struct Slot
+    {
+        uint32_t key;
+        uint32_t value;
+    };
+
+    CustomVector<Slot> slots;   // size is always power of 2;
+    size_t element_count;
+    uint32_t shift;             // 32-log2(slots.size()); used to get upper bits of hash;
+
+    size_t _slot_of(uint32_t key) const
+    {
+        return (uint32_t)(key*2654435769u)>>this->shift;    // fibonacci hashing; ids are mostly sequential so upper bits of multiplication spread them well;
+    }
+
+    void _rehash(size_t new_slots_count)
+    {
+        CustomVectorAllocatorScope scope(this->slots.get_allocator());  // new slots take memory from the same allocator as the map (not from "current()");
+        CustomVector<Slot> old_slots = std::move(this->slots);
+        this->slots = CustomVector<Slot>(new_slots_count);
+        Slot empty_slot; empty_slot.key = 0xFFFFFFFF; empty_slot.value = 0xFFFFFFFF;
+        for(size_t i = 0; i!=new_slots_count; i++) this->slots.push_back(empty_slot);
+
+        this->shift = 32;
+        for(size_t i = new_slots_count; i>1; i>>=1) this->shift--;
+
+        const size_t old_size = old_slots.size();
+        for(size_t i = 0; i!=old_size; i++)
+        {
+            if(old_slots[i].key==0xFFFFFFFF) continue;
+            size_t slot = this->_slot_of(old_slots[i].key);
+            while(this->slots[slot].key!=0xFFFFFFFF) slot = (slot+1)&(new_slots_count-1);
+            this->slots[slot] = old_slots[i];
+        }
+        return;
+    }
+
+public:
+
+    CustomIdMap()
+    {
+        this->element_count = 0;
+        this->_rehash(16);
+        return;
+    }
+
+//  adds new key or changes value of existing key;
+    void insert(uint32_t key,uint32_t value)
+    {
+        if((this->element_count+1)*2>this->slots.size()) this->_rehash(this->slots.size()*2);  // load factor is kept at max 0.5;
+
+        const size_t mask = this->slots.size()-1;
+        size_t slot = this->_slot_of(key);
+        while(this->slots[slot].key!=0xFFFFFFFF)
+        {
+            if(this->slots[slot].key==key)
+            {
+                this->slots[slot].value = value;
+                return;
+            }
+            slot = (slot+1)&mask;
+        }
+        this->slots[slot].key = key;
+        this->slots[slot].value = value;
+        this->element_count++;
+        return;
+    }
+
+//  returns value of the key or 0xFFFFFFFF if key doesn't exist;
+    uint32_t find(uint32_t key) const
+    {
+        const size_t mask = this->slots.size()-1;
+        size_t slot = this->_slot_of(key);
+        while(this->slots[slot].key!=0xFFFFFFFF)
+        {
+            if(this->slots[slot].key==key) return this->slots[slot].value;
+            slot = (slot+1)&mask;
+        }
+        return 0xFFFFFFFF;
+    }
+
+//  removes key if it exists; elements after removed one are shifted back so there's no need for "tombstones";
+    void erase(uint32_t key)
+    {
+        const size_t mask = this->slots.size()-1;
+        size_t slot = this->_slot_of(key);
+        while(this->slots[slot].key!=key)
+        {
+            if(this->slots[slot].key==0xFFFFFFFF) return;
+            slot = (slot+1)&mask;
+        }
+
+        size_t next = slot;
+        for(;;)
+        {
+            next = (next+1)&mask;
+            if(this->slots[next].key==0xFFFFFFFF) break;
+            const size_t wanted = this->_slot_of(this->slots[next].key);
+            // element from "next" can be moved to "slot" only if "slot" is not between its wanted slot and "next" (cyclically);
+            if(((next-wanted)&mask)>=((next-slot)&mask))
+            {
+                this->slots[slot] = this->slots[next];
+                slot = next;
+            }
+        }
+        this->slots[slot].key = 0xFFFFFFFF;
+        this->slots[slot].value = 0xFFFFFFFF;
+        this->element_count--;
+        return;
+    }
+
+//  removes every key; memory is shrinked to the default size;
+    void clear()
+    {
+        {
+            CustomVectorAllocatorScope scope(this->slots.get_allocator());
+            this->slots = CustomVector<Slot>(16);   // old slots are dropped before rehashing so nothing is copied back;
+        }
+        this->element_count = 0;
+        this->_rehash(16);
+        return;
+    }
+
+    size_t size() const
+    {
+        return this->element_count;
+    }
+};
+
+
+// uses macros "PUSH_WARNING_IGNORE_Wclass_memaaccess()"/"POP_WARNING()" from class "CustomVector";
+//      vector that keeps up to 'N' elements inside of the object itself and allocates memory only when there's more elements than 'N';
+//      made for short lists that usually have 0-N elements (like requirements of events) so creating,copying and iterating them doesn't touch the heap;
+//      has the same functions as "CustomVector" (except these for growing options like "change_multiplication()"); remember that moving object which keeps elements inside moves every element (not only the pointer)
+//      and that pointers to elements change after moving;
+template <typename T,size_t N> class SmallCustomVector
+{
+    static_assert(N!=0,"SmallCustomVector needs at least 1 element of inline storage");
+
+    T* main_data;           // points to "inline_data" until there's more elements than 'N';
+    size_t element_count;
+    size_t max_elements;
+    alignas(T) unsigned char inline_data[sizeof(T)*N];
+
+    T* _inline_pointer() noexcept
+    {
+        return reinterpret_cast<T*>(this->inline_data);
+    }
+
+    bool _is_inline() const noexcept
+    {
+        return this->main_data==reinterpret_cast<const T*>(this->inline_data);
+    }
+
+//  moves elements to new heap memory for "new_max_elements" elements;
+    void _reallocate(size_t new_max_elements) noexcept
+    {
+        T* copy_data = (T*)operator new(sizeof(T)*new_max_elements);
+        this->_relocate_elements(copy_data,this->main_data,this->element_count);
+        if(this->_is_inline()==0) operator delete(this->main_data);
+        this->main_data = copy_data;
+        this->max_elements = new_max_elements;
+        return;
+    }
+
+//  makes place for "count" more elements with at most one reallocation;
+    void _reserve_more(size_t count) noexcept
+    {
+        const size_t needed_elements = this->element_count+count;
+        if(needed_elements<=this->max_elements) return;
+
+        size_t new_max_elements = this->max_elements*2;
+        if(new_max_elements<needed_elements) new_max_elements = needed_elements;
+        this->_reallocate(new_max_elements);
+        return;
+    }
+
+//  moves "count" elements from "source" to not initialized memory of "destination"; elements in "source" are destroyed;
+    static void _relocate_elements(T* destination,T* source,size_t count) noexcept
+    {
+        CUSTOMVECTOR_IF_CONSTEXPR(CustomVectorTriviallyRelocatable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memcpy(destination,source,sizeof(T)*count);
+            POP_WARNING();
+        }
+        else
+        {
+            for(size_t i = 0; i!=count; i++)
+            {
+                new (&destination[i]) T(std::move(source[i]));
+                source[i].~T();
+            }
+        }
+        return;
+    }
+
+//  destroys elements,frees heap memory and comes back to the inline storage;
+    void _release() noexcept
+    {
+        CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+        {
+            for(size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
+        }
+        if(this->_is_inline()==0) operator delete(this->main_data);
+        this->main_data = this->_inline_pointer();
+        this->element_count = 0;
+        this->max_elements = N;
+        return;
+    }
+
+//  takes elements of "other" (that object must be empty and use inline storage); "other" is empty after that;
+    void _take_from(SmallCustomVector& other) noexcept
+    {
+        if(other._is_inline()==1)
+        {
+            this->_relocate_elements(this->main_data,other.main_data,other.element_count);
+            this->element_count = other.element_count;
+        }
+        else
+        {
+            this->main_data = other.main_data;
+            this->element_count = other.element_count;
+            this->max_elements = other.max_elements;
+            other.main_data = other._inline_pointer();
+            other.max_elements = N;
+        }
+        other.element_count = 0;
+        return;
+    }
+
+public:
+
+// the same types as in CustomVector; iterators are plain pointers;
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallCustomVector() noexcept
+    {
+        this->main_data = this->_inline_pointer();
+        this->element_count = 0;
+        this->max_elements = N;
+        return;
+    }
+
+// clear() destroys elements and frees heap memory if there was any;
+    void clear() noexcept
+    {
+        this->_release();
+        return;
+    }
+
+    void push_back(const T& variable) noexcept
+    {
+        if(this->element_count==this->max_elements)
+        {
+            // new element is created before moving old ones 'cause "variable" can be one of them;
+            T* copy_data = (T*)operator new(sizeof(T)*this->max_elements*2);
+            new (&copy_data[this->element_count]) T(variable);
+            this->_relocate_elements(copy_data,this->main_data,this->element_count);
+            if(this->_is_inline()==0) operator delete(this->main_data);
+            this->main_data = copy_data;
+            this->max_elements*=2;
+        }
+        else new (&this->main_data[this->element_count]) T(variable);
+        this->element_count++;
+        return;
+    }
+
+    void push_back(T&& variable) noexcept
+    {
+        if(this->element_count==this->max_elements)
+        {
+            T* copy_data = (T*)operator new(sizeof(T)*this->max_elements*2);
+            new (&copy_data[this->element_count]) T(std::move(variable));
+            this->_relocate_elements(copy_data,this->main_data,this->element_count);
+            if(this->_is_inline()==0) operator delete(this->main_data);
+            this->main_data = copy_data;
+            this->max_elements*=2;
+        }
+        else new (&this->main_data[this->element_count]) T(std::move(variable));
+        this->element_count++;
+        return;
+    }
+
+// constructs element at the end of vector from arguments of constructor of T (without temporary object);
+    template <typename... Args> void emplace_back(Args&&... arguments) noexcept
+    {
+        if(this->element_count==this->max_elements)
+        {
+            T* copy_data = (T*)operator new(sizeof(T)*this->max_elements*2);
+            new (&copy_data[this->element_count]) T(std::forward<Args>(arguments)...);    // arguments can be elements of this vector;
+            this->_relocate_elements(copy_data,this->main_data,this->element_count);
+            if(this->_is_inline()==0) operator delete(this->main_data);
+            this->main_data = copy_data;
+            this->max_elements*=2;
+        }
+        else new (&this->main_data[this->element_count]) T(std::forward<Args>(arguments)...);
+        this->element_count++;
+        return;
+    }
 
-            this->main_data = copy_data;
-            this->max_elements = this->max_elements*this->multiplication;
+// copies "count" elements to the end of vector with one check of memory; "elements" can't point to memory of this vector;
+    void append(const T* elements,size_t count) noexcept
+    {
+        if(count==0) return;
+        this->_reserve_more(count);
+
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memcpy(&this->main_data[this->element_count],elements,sizeof(T)*count);
+            POP_WARNING();
         }
-        if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        else
         {
-            this->main_data[this->element_count] = variable;
+            for(size_t i = 0; i!=count; i++) new (&this->main_data[this->element_count+i]) T(elements[i]);
         }
-        else new (&this->main_data[this->element_count]) T(std::move(variable));
-        this->element_count++;
+        this->element_count+=count;
         return;
     }
 
@@ -212,17 +1561,16 @@ public:
         if(last>=this->element_count) last = this->element_count-1;
         if(first>last) return;
 
-        for(size_t i = first; i<=last; i++) this->main_data[i].~T();
-
-        if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
         {
-            for(size_t i = last+1,j = first; i<this->element_count; i++,j++)
-            {
-                this->main_data[j] = this->main_data[i];
-            }
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memmove(&this->main_data[first],&this->main_data[last+1],sizeof(T)*(this->element_count-last-1));
+            POP_WARNING();
         }
         else
         {
+            for(size_t i = first; i<=last; i++) this->main_data[i].~T();
+
             for(size_t i = last+1,j = first; i<this->element_count; i++,j++)
             {
                 new (&this->main_data[j]) T(std::move(this->main_data[i]));
@@ -231,85 +1579,187 @@ public:
         }
 
         this->element_count-=(last-first)+1;
+        return;
+    }
+
+// removes element by moving the last element in its place; O(1) but order of elements isn't kept;
+    void erase_unordered(size_t index) noexcept
+    {
+        if(index>=this->element_count) return;
+        this->element_count--;
+        if(index==this->element_count)
+        {
+            this->main_data[index].~T();
+            return;
+        }
 
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        {
+            this->main_data[index] = this->main_data[this->element_count];
+        }
+        else
+        {
+            this->main_data[index].~T();
+            new (&this->main_data[index]) T(std::move(this->main_data[this->element_count]));
+            this->main_data[this->element_count].~T();
+        }
         return;
     }
 
-    void reserve(size_t elements) noexcept
+// removes every element for which "predicate(element)" returns true in one pass (order of the rest is kept); returns count of removed elements;
+    template <typename Predicate> size_t erase_if(Predicate predicate)
     {
-        if (elements==0) elements = 1;
-        if(elements<=this->max_elements) return;
+        size_t new_size = 0;
+        for(size_t i = 0; i!=this->element_count; i++)
+        {
+            if(predicate(this->main_data[i]))
+            {
+                this->main_data[i].~T();
+                continue;
+            }
+            if(i!=new_size)
+            {
+                new (&this->main_data[new_size]) T(std::move(this->main_data[i]));
+                this->main_data[i].~T();
+            }
+            new_size++;
+        }
 
-        this->size_of_objects = sizeof(T)*elements;
+        const size_t removed_elements = this->element_count-new_size;
+        this->element_count = new_size;
+        return removed_elements;
+    }
+
+// inserts "count" elements before element at "position" (or at the end if "position" is bigger than size());
+//      "elements" can't point to memory of this vector;
+    void insert(size_t position,const T* elements,size_t count) noexcept
+    {
+        if(count==0) return;
+        if(position>this->element_count) position = this->element_count;
+        this->_reserve_more(count);
 
-        T* copy_data = (T*)operator new(this->size_of_objects);
-        if(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
         {
             PUSH_WARNING_IGNORE_Wclass_memaaccess();
-            memcpy(copy_data,this->main_data,sizeof(T)*this->element_count);
+            memmove(&this->main_data[position+count],&this->main_data[position],sizeof(T)*(this->element_count-position));
+            memcpy(&this->main_data[position],elements,sizeof(T)*count);
             POP_WARNING();
         }
         else
         {
-            for (size_t i = 0; i!=this->element_count; i++)
+            for(size_t i = this->element_count; i!=position; i--)
             {
-                new (&copy_data[i]) T(std::move(this->main_data[i]));
-                this->main_data[i].~T();
+                new (&this->main_data[i-1+count]) T(std::move(this->main_data[i-1]));
+                this->main_data[i-1].~T();
             }
+            for(size_t i = 0; i!=count; i++) new (&this->main_data[position+i]) T(elements[i]);
         }
-        operator delete(this->main_data);
-
-        this->main_data = copy_data;
-        this->max_elements = elements;
+        this->element_count+=count;
         return;
     }
 
-// if "element_count" is 0,then function forces minimum 1 element to be allocated in this class;
-    void shrink_to_fit() noexcept
+    void insert(size_t position,const T& variable) noexcept
     {
-        if(this->element_count==this->max_elements) return;
-
-        size_t forced_miminum_1_element_allocate = 0;
-        if(this->element_count==0) forced_miminum_1_element_allocate = 1;
+        T copy_variable(variable);  // "variable" can be element of this vector;
+        this->insert(position,std::move(copy_variable));
+        return;
+    }
 
-        this->size_of_objects = sizeof(T)*(this->element_count+forced_miminum_1_element_allocate);
+    void insert(size_t position,T&& variable) noexcept
+    {
+        if(position>this->element_count) position = this->element_count;
+        this->_reserve_more(1);
 
-        T* copy_data = (T*)operator new(this->size_of_objects);
-        if (std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)   // optymalization for variables like int (not classes with constructors);
         {
             PUSH_WARNING_IGNORE_Wclass_memaaccess();
-            memcpy(copy_data,this->main_data,sizeof(T)*this->element_count);
+            memmove(&this->main_data[position+1],&this->main_data[position],sizeof(T)*(this->element_count-position));
             POP_WARNING();
         }
         else
         {
-            for (size_t i = 0; i!=this->element_count; i++)
+            for(size_t i = this->element_count; i!=position; i--)
             {
-                new (&copy_data[i]) T(std::move(this->main_data[i]));
-                this->main_data[i].~T();
+                new (&this->main_data[i]) T(std::move(this->main_data[i-1]));
+                this->main_data[i-1].~T();
             }
         }
-        operator delete(this->main_data);
+        new (&this->main_data[position]) T(std::move(variable));
+        this->element_count++;
+        return;
+    }
 
-        this->main_data = copy_data;
-        this->max_elements = this->element_count+forced_miminum_1_element_allocate;
+// makes heap memory for "elements" elements if it's more than actual capacity;
+    void reserve(size_t elements) noexcept
+    {
+        if(elements<=this->max_elements) return;
+        this->_reallocate(elements);
+        return;
+    }
+
+// comes back to the inline storage if elements fit in it; otherwise shrinks heap memory to size();
+    void shrink_to_fit() noexcept
+    {
+        if(this->_is_inline()==1||this->element_count==this->max_elements) return;
 
+        if(this->element_count<=N)
+        {
+            T* heap_data = this->main_data;
+            this->main_data = this->_inline_pointer();
+            this->_relocate_elements(this->main_data,heap_data,this->element_count);
+            operator delete(heap_data);
+            this->max_elements = N;
+            return;
+        }
+        this->_reallocate(this->element_count);
         return;
     }
 
-// changes multiplication of growing array when using function "push_back()";
-    void change_multiplication(size_t new_multiplication)
+// changes size of vector; new elements are copies of "variable"; removed elements are destroyed;
+    void resize(size_t new_size,const T& variable) noexcept
     {
-        if(new_multiplication<2) this->multiplication = 2;
-        else this->multiplication = new_multiplication;
+        if(new_size<=this->element_count)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for(size_t i = new_size; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->element_count = new_size;
+            return;
+        }
+
+        T copy_variable(variable);  // "variable" can be element of this vector;
+        this->_reserve_more(new_size-this->element_count);
+        for(size_t i = this->element_count; i!=new_size; i++) new (&this->main_data[i]) T(copy_variable);
+        this->element_count = new_size;
         return;
     }
 
-// changes starting reserve size for elements; used by function "clear()":
-    void change_elements_count_start(size_t new_elements_count_start)
+// new elements are value-initialized (0 for int and other simple types);
+    void resize(size_t new_size) noexcept
     {
-        if(new_elements_count_start==0) this->elements_count_start = 1;
-        else this->elements_count_start = new_elements_count_start;
+        if(new_size<=this->element_count)
+        {
+            CUSTOMVECTOR_IF_CONSTEXPR(!std::is_trivially_copyable<T>::value)
+            {
+                for(size_t i = new_size; i!=this->element_count; i++) this->main_data[i].~T();
+            }
+            this->element_count = new_size;
+            return;
+        }
+
+        this->_reserve_more(new_size-this->element_count);
+        for(size_t i = this->element_count; i!=new_size; i++) new (&this->main_data[i]) T();
+        this->element_count = new_size;
+        return;
+    }
+
+// changes size of vector without initializing new elements (they have to be written before reading); only for trivially copyable types;
+    void resize_uninitialized(size_t new_size) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value,"resize_uninitialized() needs trivially copyable type");
+        if(new_size>this->element_count) this->_reserve_more(new_size-this->element_count);
+        this->element_count = new_size;
         return;
     }
 
@@ -318,9 +1768,10 @@ public:
         return this->element_count;
     }
 
+// bytes of memory for elements (inline storage or heap memory);
     size_t real_size_in_bytes() const
     {
-        return this->size_of_objects;
+        return this->max_elements*sizeof(T);
     }
 
     size_t size_of_elements_in_bytes() const
@@ -330,7 +1781,66 @@ public:
 
     bool empty() const
     {
-        return 1 ? this->element_count == 0 : 0;
+        return (this->element_count==0);
+    }
+
+// pointer to the first element; valid until next function that changes size/capacity of vector (like "push_back()") or moving of this object;
+    T* data()
+    {
+        return this->main_data;
+    }
+
+    const T* data() const
+    {
+        return this->main_data;
+    }
+
+    T* begin()
+    {
+        return this->main_data;
+    }
+
+    const T* begin() const
+    {
+        return this->main_data;
+    }
+
+    T* end()
+    {
+        return this->main_data+this->element_count;
+    }
+
+    const T* end() const
+    {
+        return this->main_data+this->element_count;
+    }
+
+    const T* cbegin() const
+    {
+        return this->main_data;
+    }
+
+    const T* cend() const
+    {
+        return this->main_data+this->element_count;
+    }
+
+#if __cplusplus>=202002L
+    std::span<T> get_span()
+    {
+        return std::span<T>(this->main_data,this->element_count);
+    }
+
+    std::span<const T> get_span() const
+    {
+        return std::span<const T>(this->main_data,this->element_count);
+    }
+#endif
+
+//  returns 1 if elements are kept inside of the object (without heap memory);
+    bool is_inline() const
+    {
+        return this->_is_inline();
     }
 
     const T& operator[](const size_t iterator) const
@@ -345,173 +1855,63 @@ public:
         return this->main_data[iterator];
     }
 
-
-    ~CustomVector() noexcept
+    ~SmallCustomVector() noexcept
     {
-        if(this->main_data!=NULL)
-        {
-            if(!std::is_trivially_copyable<T>::value)
-            {
-                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
-            }
-            operator delete(this->main_data);
-            this->main_data = NULL;
-        }
+        this->_release();
         return;
     }
 
 //  implementation for "rule of the five" needed 'cause of manual memory management existing in class (new/malloc);
 //------------------------------------------------------------------------------------------------------------------------------
 
-//  copying constructor; used like:
-//      Class object0 = object1;
-//      Class object0 = return_object();
-//          [inside return_object]:
-//          return object2;
-    CustomVector(const CustomVector& other)
+    SmallCustomVector(const SmallCustomVector& other)
     {
-        this->multiplication = other.multiplication;
-        this->elements_count_start = other.elements_count_start;
-        this->element_count = other.element_count;
-        this->max_elements = other.max_elements;
-        this->size_of_objects = other.size_of_objects;
-        this->main_data = (T*)operator new(this->size_of_objects);
-
-
-        if(std::is_trivially_copyable<T>::value)
-        {
-            PUSH_WARNING_IGNORE_Wclass_memaaccess();
-            memcpy(this->main_data,other.main_data,sizeof(T)*this->element_count);
-            POP_WARNING();
-        }
-        else
-        {
-            for (size_t i = 0; i!=this->element_count; i++) new (&this->main_data[i]) T(other.main_data[i]);
-        }
-
+        this->main_data = this->_inline_pointer();
+        this->element_count = 0;
+        this->max_elements = N;
+        *this = other;
         return;
     }
 
-//  copying operator; used like:
-//      object0 = object1;
-//      object0 = return_object();
-//          [inside return_object]:
-//          return object2;
-    CustomVector& operator=(const CustomVector& other)
+    SmallCustomVector& operator=(const SmallCustomVector& other)
     {
         if (this==&other) return *this;   // check if you're using operator '=' with the same object;
 
-        if(other.element_count>this->max_elements)  //  optymalization;
-        {
-            if(this->main_data!=NULL)
-            {
-                if(!std::is_trivially_copyable<T>::value)
-                {
-                    for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
-                }
-                operator delete(this->main_data);
-            }
-
-            // this->multiplication = other.multiplication;             // i want multiplication to be set as original has been setted;
-            //this->elements_count_start = other.elements_count_start;  // i want elements_count_start to be set as original has been setted;
-            this->element_count = other.element_count;
-            this->max_elements = other.max_elements;
-            this->size_of_objects = other.size_of_objects;
-            this->main_data = (T*)operator new(this->size_of_objects);
-
-            if(std::is_trivially_copyable<T>::value)
-            {
-                PUSH_WARNING_IGNORE_Wclass_memaaccess();
-                memcpy(this->main_data,other.main_data,sizeof(T)*this->element_count);
-                POP_WARNING();
-            }
-            else
-            {
-                for (size_t i = 0; i!=this->element_count; i++) new (&this->main_data[i]) T(other.main_data[i]);
-            }
+        this->_release();
+        if(other.element_count>N) this->_reallocate(other.max_elements);
 
+        CUSTOMVECTOR_IF_CONSTEXPR(std::is_trivially_copyable<T>::value)
+        {
+            PUSH_WARNING_IGNORE_Wclass_memaaccess();
+            memcpy(this->main_data,other.main_data,sizeof(T)*other.element_count);
+            POP_WARNING();
         }
-        else    // main_data is large enough;
+        else
         {
-            if(!std::is_trivially_copyable<T>::value)
-            {
-                for(size_t i = other.element_count; i<this->element_count; i++) this->main_data[i].~T();
-
-                for(size_t i = 0; i!=other.element_count; i++)
-                {
-                    if (i<this->element_count) this->main_data[i] = other.main_data[i];
-                    else new (&this->main_data[i]) T(other.main_data[i]);
-                }
-            }
-            else
-            {
-                PUSH_WARNING_IGNORE_Wclass_memaaccess();
-                memcpy(this->main_data,other.main_data,sizeof(T)*other.element_count);
-                POP_WARNING();
-            }
-
-            this->element_count = other.element_count;
+            for (size_t i = 0; i!=other.element_count; i++) new (&this->main_data[i]) T(other.main_data[i]);
         }
+        this->element_count = other.element_count;
 
         return *this;
     }
 
-//  moving constructor; used like:
-//      Class object0 = Class();
-//      Class object0 = std::move(object1);
-//      Class object0 = return_object();
-//          [inside return_object]:
-//          return Class();
-    CustomVector(CustomVector&& other) noexcept   // noexcept is important for new c++ gadgets to inform that function doesn't throw exception
-    {                                                //     so function that doesn't support exception can run this function except copying function;
-        this->main_data = other.main_data;
-        this->element_count = other.element_count;
-        this->size_of_objects = other.size_of_objects;
-        this->max_elements = other.max_elements;
-        this->multiplication = other.multiplication;
-        this->elements_count_start = other.elements_count_start;
-
-        other.main_data = NULL;
-        other.element_count = 0;
-        other.size_of_objects = 0;
-        other.max_elements = 0;
-
+    SmallCustomVector(SmallCustomVector&& other) noexcept
+    {
+        this->main_data = this->_inline_pointer();
+        this->element_count = 0;
+        this->max_elements = N;
+        this->_take_from(other);
         return;
     }
 
-//  moving operator; used like:
-//      object0 = Class();
-//      object0 = std::move(object1);
-//      object0 = return_object();
-//          [inside return_object]:
-//          return Class();
-    CustomVector& operator=(CustomVector&& other) noexcept // noexcept is important for new c++ gadgets to inform that function doesn't throw exception
-    {                                                          //     so function that doesn't support exception can run this function except copying function;
+    SmallCustomVector& operator=(SmallCustomVector&& other) noexcept
+    {
         if (this==&other) return *this;     // check if you're using operator '=' with the same object;
 
-        if (this->main_data!=NULL)
-        {
-            if(!std::is_trivially_copyable<T>::value)
-            {
-                for (size_t i = 0; i!=this->element_count; i++) this->main_data[i].~T();
-            }
-            operator delete(this->main_data);
-        }
-
-        this->main_data = other.main_data;
-        this->element_count = other.element_count;
-        this->size_of_objects = other.size_of_objects;
-        this->max_elements = other.max_elements;
-        //this->multiplication = other.multiplication;
-        //this->elements_count_start = other.elements_count_start;
-
-        other.main_data = NULL;
-        other.element_count = 0;
-        other.size_of_objects = 0;
-        other.max_elements = 0;
-
+        this->_release();
+        this->_take_from(other);
         return *this;
     }
 //------------------------------------------------------------------------------------------------------------------------------
 
-};
\ No newline at end of file
+};
@@ -0,0 +1,29 @@
+#ifndef S2T_BENCH_TOOLS_H
+#define S2T_BENCH_TOOLS_H
+
+// tools shared by benchmarks of "CustomVector" that measure whole runs in milliseconds;
+// #include <stdint.h>  for int32_t
+// #include <stddef.h>  for size_t
+// #include <chrono>    for "std::chrono::steady_clock"
+#include <stdint.h>
+#include <stddef.h>
+#include <chrono>
+
+// results of measured functions are added here so compilator can't remove their work;
+static volatile size_t sink = 0;
+
+// runs "function" 5 times and returns the best time in milliseconds;
+template <typename F> static double measure(F function)
+{
+    double best = 1e30;
+    for(int32_t repeat = 0; repeat<5; repeat++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        function();
+        const double ms = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-start).count();
+        if(ms<best) best = ms;
+    }
+    return best;
+}
+
+#endif
@@ -0,0 +1,72 @@
+// benchmark of mouse hit-test of "cSDL_ButtonsManager" (linear search vs spatial index) against count of buttons;
+//      no window is opened; SDL_MOUSEMOTION events are made by hand and passed to "run_event_checker()";
+// build and run (from main directory of repository):
+//      g++ -O2 -std=c++11 -I. benchmarks/buttons_hit_test_bench.cpp -o buttons_hit_test_bench `sdl2-config --cflags --libs` -lSDL2_image && ./buttons_hit_test_bench
+// every result is the best of 5 repeats in nanoseconds per one mouse motion (lower is better);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <chrono>
+
+// "layout" 0: buttons in rows (like inventory) 36x26 px every 40x30 px;
+// "layout" 1: random buttons 10-90 px on 1920x1080 screen (they overlap);
+// "layout" 2: every button covers almost whole screen (the worst case for grid, they're kept in list of large buttons);
+static double measure(uint32_t count_of_buttons,int32_t layout,bool spatial_index)
+{
+    cSDL_ButtonsManager manager;
+    manager.enable_spatial_index(spatial_index,64);
+    srand(1);
+    for(uint32_t i = 0; i<count_of_buttons; i++)
+    {
+        SDL_Rect rect;
+        if(layout==0) {rect.x = (i%200)*40; rect.y = (i/200)*30; rect.w = 36; rect.h = 26;}
+        else if(layout==1) {rect.x = rand()%1920; rect.y = rand()%1080; rect.w = 10+rand()%80; rect.h = 10+rand()%80;}
+        else {rect.x = i%50; rect.y = i%40; rect.w = 1800; rect.h = 1000;}
+        manager.create_button(rect,1,i);
+    }
+    manager.set_manually_focus_device(cSDL_ButtonsManager::MOUSE);
+
+    SDL_Event event;
+    memset(&event,0,sizeof(event));
+    event.type = SDL_MOUSEMOTION;
+    event.motion.x = 0; event.motion.y = 0;
+    manager.run_event_checker(&event);  // index is built lazily so it isn't measured;
+
+    const int32_t motions = 20000;
+    volatile uint32_t sink = 0;
+    double best = 1e30;
+    for(int32_t repeat = 0; repeat<5; repeat++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int32_t q = 0; q<motions; q++)
+        {
+            event.motion.x = (int32_t)((uint32_t)q*7919u%1920u);
+            event.motion.y = (int32_t)((uint32_t)q*104729u%1080u);
+            manager.run_event_checker(&event);
+            sink+=manager.get_focused_button_id();
+        }
+        const double ns = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count()/motions;
+        if(ns<best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    const char* layout_names[3] = {"rows","random","fullscreen"};
+    const uint32_t counts[5] = {100,1000,5000,20000,50000};
+
+    printf("%-12s %8s %14s %14s\n","layout","buttons","linear ns","grid ns");
+    for(int32_t layout = 0; layout<3; layout++)
+    {
+        for(int32_t c = 0; c<5; c++)
+        {
+            if(layout==2&&counts[c]>5000) continue;    // every query has to check every button there so it's as slow as linear;
+            printf("%-12s %8u %14.1f %14.1f\n",layout_names[layout],counts[c],measure(counts[c],layout,0),measure(counts[c],layout,1));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// benchmark of mouse motion throughput of "cSDL_ButtonsManager" with 5000 buttons with scaling mechanism ON and OFF;
+//      hitboxes are scaled once (after "update_scaling_mechanism()") and not by every motion so both cases should cost the same;
+//      no window is opened; SDL_MOUSEMOTION events are made by hand and passed to "run_event_checker()";
+// build and run (from main directory of repository):
+//      g++ -O2 -std=c++11 -I. benchmarks/buttons_scaling_bench.cpp -o buttons_scaling_bench `sdl2-config --cflags --libs` -lSDL2_image && ./buttons_scaling_bench
+// every result is the best of 5 repeats;
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <chrono>
+
+static double measure(bool spatial_index,bool scaling)
+{
+    const uint32_t count_of_buttons = 5000;
+    cSDL_ButtonsManager manager;
+    manager.enable_spatial_index(spatial_index,0);
+    srand(1);
+    for(uint32_t i = 0; i<count_of_buttons; i++)
+    {
+        SDL_Rect rect = {rand()%1900,rand()%1000,30,20};
+        if(scaling==0)  // the same hitboxes as after scaling 1920x1080 -> 1280x720 so both cases check the same buttons;
+        {
+            rect.x = rect.x*1280/1920; rect.w = rect.w*1280/1920;
+            rect.y = rect.y*720/1080; rect.h = rect.h*720/1080;
+        }
+        manager.create_button(rect,1,i);
+    }
+    if(scaling==1)
+    {
+        manager.enable_scaling_mechanism(1);
+        manager.update_scaling_mechanism(1920,1080,1280,720);
+    }
+    manager.set_manually_focus_device(cSDL_ButtonsManager::MOUSE);
+
+    SDL_Event event;
+    memset(&event,0,sizeof(event));
+    event.type = SDL_MOUSEMOTION;
+    manager.run_event_checker(&event);  // caches are built lazily so they aren't measured;
+
+    const int32_t motions = (spatial_index==1) ? 1000000 : 50000;
+    volatile uint32_t sink = 0;
+    double best = 1e30;
+    for(int32_t repeat = 0; repeat<5; repeat++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int32_t q = 0; q<motions; q++)
+        {
+            event.motion.x = (int32_t)((uint32_t)q*7919u%1280u);
+            event.motion.y = (int32_t)((uint32_t)q*104729u%720u);
+            manager.run_event_checker(&event);
+            sink+=manager.get_focused_button_id();
+        }
+        const double ns = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count()/motions;
+        if(ns<best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    printf("%-14s %-8s %12s %16s\n","search","scaling","ns/motion","M motions/s");
+    for(int32_t spatial_index = 0; spatial_index<2; spatial_index++)
+    {
+        for(int32_t scaling = 0; scaling<2; scaling++)
+        {
+            const double ns = measure(spatial_index,scaling);
+            printf("%-14s %-8s %12.1f %16.2f\n",(spatial_index==1) ? "spatial index" : "linear",(scaling==1) ? "ON" : "OFF",ns,1000.0/ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// benchmark of building and destroying of one ui screen (cSDL_ButtonsManager with 2000 buttons and 200 events + 300 position tables)
+//      with memory from global heap against memory from "CustomBumpArena" (everything is freed at once with "reset()");
+//      no window is opened; only containers are built;
+// build and run (from main directory of repository):
+//      g++ -O2 -std=c++11 -I. benchmarks/customvector_arena_bench.cpp -o customvector_arena_bench `sdl2-config --cflags --libs` -lSDL2_image && ./customvector_arena_bench
+// every result is the best of 5 repeats in microseconds per one screen (lower is better);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <chrono>
+
+static void empty_callback(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj)
+{
+    (void)user_data; (void)event; (void)class_obj;
+    return;
+}
+
+// "arena" NULL == global heap;
+static double build_screens(CustomBumpArena* arena,uint32_t screens)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(uint32_t screen = 0; screen<screens; screen++)
+    {
+        CustomVectorAllocatorScope scope(arena);
+        cSDL_ButtonsManager* manager = new cSDL_ButtonsManager();
+        CustomVector<CustomVector<SDL_Rect>> tables;
+        for(uint32_t i = 0; i<2000; i++)
+        {
+            SDL_Rect rect = {(int32_t)(i%40*45),(int32_t)(i/40*25),40,20};
+            manager->create_button(rect,1,i);
+        }
+        for(uint32_t i = 0; i<200; i++)
+        {
+            const uint32_t id = manager->create_event(empty_callback,NULL);
+            manager->add_required_key_for_event(id,cSDL_ButtonsManager::DOWN,'a'+i%26);
+        }
+        for(uint32_t i = 0; i<300; i++)
+        {
+            CustomVector<SDL_Rect> table;
+            for(uint32_t k = 0; k<32; k++) {SDL_Rect rect = {(int32_t)k,(int32_t)k,1,1}; table.push_back(rect);}
+            tables.push_back(std::move(table));
+        }
+        manager->force_buttons_cache_update();
+        delete manager;
+        tables.clear();
+        if(arena!=NULL) arena->reset();
+    }
+    return std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now()-start).count()/screens;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    // big arrays of the manager don't fit in small blocks so they take own blocks (arena is close to heap then);
+    CustomBumpArena arena_small_blocks(256*1024);
+    CustomBumpArena arena_big_blocks(4*1024*1024);
+    double best_heap = 1e30,best_small = 1e30,best_big = 1e30;
+    for(int32_t repeat = 0; repeat<5; repeat++)
+    {
+        const double heap = build_screens(NULL,200);
+        const double small = build_screens(&arena_small_blocks,200);
+        const double big = build_screens(&arena_big_blocks,200);
+        if(heap<best_heap) best_heap = heap;
+        if(small<best_small) best_small = small;
+        if(big<best_big) best_big = big;
+    }
+    printf("%-24s %12s\n","memory","us/screen");
+    printf("%-24s %12.1f\n","heap",best_heap);
+    printf("%-24s %12.1f\n","arena (256 KB blocks)",best_small);
+    printf("%-24s %12.1f\n","arena (4 MB blocks)",best_big);
+    return 0;
+}
@@ -0,0 +1,153 @@
+// benchmark of CustomVector against std::vector (push_back copy/move, reserve, shrink_to_fit, erase, copy/move assign, constructor)
+//      for 3 types: "int" == unsigned int, "pod16" == struct of 4 unsigned ints, "string24" == struct with std::string of 24 chars (not trivially copyable);
+//      it's the harness used for table "Benchmarks on modern hardware" above class CustomVector in "_s2t_tools.h";
+//      every case is run once for warm-up and then 31 times; printed is median time and spread (interquartile range/median);
+//      ratio is std::vector time/CustomVector time (>1 == CustomVector is faster);
+// build and run (from main directory of repository; the table has results of both):
+//      g++ -O2 -std=c++11 -I. benchmarks/customvector_bench.cpp -o customvector_bench && ./customvector_bench
+//      g++ -O0 -std=c++11 -I. benchmarks/customvector_bench.cpp -o customvector_bench_O0 && ./customvector_bench_O0
+
+#include "_s2t_tools.h"
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+
+struct Pod16
+{
+    uint32_t a; uint32_t b; uint32_t c; uint32_t d;
+};
+
+struct NonTrivial
+{
+    std::string text;
+    NonTrivial() : text() {}
+    explicit NonTrivial(uint32_t i) : text(24,(char)('a'+i%26)) {}
+};
+
+template <typename T> T make_value(uint32_t i);
+template <> uint32_t make_value<uint32_t>(uint32_t i) {return i;}
+template <> Pod16 make_value<Pod16>(uint32_t i) {Pod16 pod = {i,i+1,i+2,i+3}; return pod;}
+template <> NonTrivial make_value<NonTrivial>(uint32_t i) {return NonTrivial(i);}
+
+static volatile size_t sink = 0;
+static const uint32_t ELEMENTS = 100000;
+
+struct Result
+{
+    double median_us;
+    double spread_percent;
+};
+
+template <typename F> static Result measure(F function)
+{
+    const int32_t runs = 31;
+    double times[runs];
+    function();     // warm-up;
+    for(int32_t run = 0; run<runs; run++)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        function();
+        times[run] = std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now()-start).count();
+    }
+    std::sort(times,times+runs);
+    Result result;
+    result.median_us = times[runs/2];
+    result.spread_percent = (times[runs*3/4]-times[runs/4])/times[runs/2]*100.0;
+    return result;
+}
+
+// 10 elements from index 10 are erased 200 times; CustomVector takes inclusive range of indexes;
+template <typename T> static void erase_elements(CustomVector<T>& vector)
+{
+    for(int32_t k = 0; k<200; k++) vector.erase(10,19);
+    return;
+}
+
+template <typename T> static void erase_elements(std::vector<T>& vector)
+{
+    for(int32_t k = 0; k<200; k++) vector.erase(vector.begin()+10,vector.begin()+20);
+    return;
+}
+
+template <typename V,typename T> static Result push_back_copy()
+{
+    return measure([](){V vector; for(uint32_t i = 0; i<ELEMENTS; i++) {T value = make_value<T>(i); vector.push_back(value);} sink+=vector.size();});
+}
+
+template <typename V,typename T> static Result push_back_move()
+{
+    return measure([](){V vector; for(uint32_t i = 0; i<ELEMENTS; i++) {T value = make_value<T>(i); vector.push_back(std::move(value));} sink+=vector.size();});
+}
+
+template <typename V,typename T> static Result reserve()
+{
+    return measure([](){for(uint32_t k = 0; k<200; k++) {V vector; vector.reserve(ELEMENTS/10); vector.push_back(make_value<T>(k)); sink+=vector.size();}});
+}
+
+template <typename V,typename T> static Result shrink_to_fit()
+{
+    V base;
+    for(uint32_t i = 0; i<ELEMENTS; i++) base.push_back(make_value<T>(i));
+    return measure([&](){V vector = base; vector.push_back(make_value<T>(1)); vector.shrink_to_fit(); sink+=vector.size();});
+}
+
+template <typename V,typename T> static Result erase()
+{
+    V base;
+    for(uint32_t i = 0; i<ELEMENTS/10; i++) base.push_back(make_value<T>(i));
+    return measure([&](){V vector = base; erase_elements(vector); sink+=vector.size();});
+}
+
+template <typename V,typename T> static Result copy_assign()
+{
+    V base;
+    for(uint32_t i = 0; i<ELEMENTS; i++) base.push_back(make_value<T>(i));
+    return measure([&](){V vector; vector = base; sink+=vector.size();});
+}
+
+template <typename V,typename T> static Result move_assign()
+{
+    return measure([](){
+        V first;
+        for(uint32_t i = 0; i<1000; i++) first.push_back(make_value<T>(i));
+        for(uint32_t k = 0; k<1000; k++) {V second; second = std::move(first); first = std::move(second);}
+        sink+=first.size();
+    });
+}
+
+template <typename V,typename T> static Result constructor()
+{
+    return measure([](){for(uint32_t k = 0; k<ELEMENTS; k++) {V vector; sink+=vector.size();}});
+}
+
+static void print_row(const char* operation,const char* type_name,Result custom,Result standard)
+{
+    printf("%-15s %-9s %11.1f us (%5.1f%%) %11.1f us (%5.1f%%) %8.2f\n",operation,type_name,
+           custom.median_us,custom.spread_percent,standard.median_us,standard.spread_percent,standard.median_us/custom.median_us);
+    return;
+}
+
+template <typename T> static void run_type(const char* type_name)
+{
+    print_row("push_back copy",type_name,push_back_copy<CustomVector<T>,T>(),push_back_copy<std::vector<T>,T>());
+    print_row("push_back move",type_name,push_back_move<CustomVector<T>,T>(),push_back_move<std::vector<T>,T>());
+    print_row("reserve",type_name,reserve<CustomVector<T>,T>(),reserve<std::vector<T>,T>());
+    print_row("shrink_to_fit",type_name,shrink_to_fit<CustomVector<T>,T>(),shrink_to_fit<std::vector<T>,T>());
+    print_row("erase",type_name,erase<CustomVector<T>,T>(),erase<std::vector<T>,T>());
+    print_row("copy assign",type_name,copy_assign<CustomVector<T>,T>(),copy_assign<std::vector<T>,T>());
+    print_row("move assign",type_name,move_assign<CustomVector<T>,T>(),move_assign<std::vector<T>,T>());
+    print_row("constructor",type_name,constructor<CustomVector<T>,T>(),constructor<std::vector<T>,T>());
+    return;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    printf("%-15s %-9s %24s %24s %8s\n","case","type","CustomVector (spread)","std::vector (spread)","ratio");
+    run_type<uint32_t>("int");
+    run_type<Pod16>("pod16");
+    run_type<NonTrivial>("string24");
+    return 0;
+}
@@ -0,0 +1,56 @@
+// benchmark of bulk functions of CustomVector ("append()","emplace_back()","resize()","resize_uninitialized()","insert()") against std::vector;
+//      "append()" is also compared with loop of "push_back()" (the only way to add elements before these functions);
+// build and run (from main directory of repository):
+//      g++ -O2 -std=c++11 -I. benchmarks/customvector_bulk_bench.cpp -o customvector_bulk_bench && ./customvector_bulk_bench
+// every result is the best of 5 repeats in milliseconds (lower is better);
+
+#include "_s2t_tools.h"
+#include <stdio.h>
+#include <vector>
+#include "_bench_tools.h"
+
+struct Rect16   // the same layout as SDL_Rect;
+{
+    int32_t x; int32_t y; int32_t w; int32_t h;
+};
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    const uint32_t tables = 200000;
+    Rect16 source[64];
+    for(int32_t i = 0; i<64; i++) {Rect16 rect = {i,i,i,i}; source[i] = rect;}
+
+    printf("%-40s %14s %14s\n","case","CustomVector","std::vector");
+
+    // position table of 64 rects built from scratch (like segments of slider);
+    const double custom_append = measure([&](){
+        for(uint32_t i = 0; i<tables; i++) {CustomVector<Rect16> table; table.append(source,64); sink+=table.size();}
+    });
+    const double custom_push_back_loop = measure([&](){
+        for(uint32_t i = 0; i<tables; i++) {CustomVector<Rect16> table; for(int32_t k = 0; k<64; k++) table.push_back(source[k]); sink+=table.size();}
+    });
+    const double std_insert = measure([&](){
+        for(uint32_t i = 0; i<tables; i++) {std::vector<Rect16> table; table.insert(table.end(),source,source+64); sink+=table.size();}
+    });
+    printf("%-40s %11.1f ms %11.1f ms\n","append 64 rects x200000",custom_append,std_insert);
+    printf("%-40s %11.1f ms %14s\n","  (push_back loop instead of append)",custom_push_back_loop,"-");
+
+    printf("%-40s %11.1f ms %11.1f ms\n","emplace_back 1M rects",
+        measure([&](){CustomVector<Rect16> rects; for(int32_t i = 0; i<1000000; i++) rects.emplace_back(source[i&63]); sink+=rects.size();}),
+        measure([&](){std::vector<Rect16> rects; for(int32_t i = 0; i<1000000; i++) rects.emplace_back(source[i&63]); sink+=rects.size();}));
+
+    printf("%-40s %11.1f ms %11.1f ms\n","resize 0->1M int x50",
+        measure([&](){for(int32_t r = 0; r<50; r++) {CustomVector<int32_t> values; values.resize(1000000); sink+=values[(r*7919)%1000000]+values.size();}}),
+        measure([&](){for(int32_t r = 0; r<50; r++) {std::vector<int32_t> values; values.resize(1000000); sink+=values[(r*7919)%1000000]+values.size();}}));
+    printf("%-40s %11.1f ms %14s\n","resize_uninitialized 0->1M int x50",
+        measure([&](){for(int32_t r = 0; r<50; r++) {CustomVector<int32_t> values; values.resize_uninitialized(1000000); values[(r*7919)%1000000] = 1; sink+=values[(r*7919)%1000000]+values.size();}}),"-");
+
+    printf("%-40s %11.1f ms %11.1f ms\n","insert at front 20000 int",
+        measure([&](){CustomVector<int32_t> values; for(int32_t i = 0; i<20000; i++) values.insert(0,i); sink+=values.size();}),
+        measure([&](){std::vector<int32_t> values; for(int32_t i = 0; i<20000; i++) values.insert(values.begin(),i); sink+=values.size();}));
+    printf("%-40s %11.1f ms %11.1f ms\n","insert 64 rects in the middle x2000",
+        measure([&](){CustomVector<Rect16> rects; for(int32_t i = 0; i<2000; i++) rects.insert(rects.size()/2,source,64); sink+=rects.size();}),
+        measure([&](){std::vector<Rect16> rects; for(int32_t i = 0; i<2000; i++) rects.insert(rects.begin()+rects.size()/2,source,source+64); sink+=rects.size();}));
+    return 0;
+}
@@ -0,0 +1,96 @@
+// benchmark of growing/shrinking of big CustomVector with trivially copyable elements (pixels/vertices) against std::vector;
+//      by default memory of such vectors is moved with realloc(); glibc moves blocks above its mmap threshold with mremap() (pages are only remapped
+//      without copying), but the threshold grows up to 32 MB on 64-bit after the first such block is freed, so smaller blocks can be copied anyway;
+//      build it twice to compare with the old path (operator new + memcpy of every element at every growth):
+// build and run (from main directory of repository):
+//      g++ -O2 -std=c++11 -I. benchmarks/customvector_realloc_bench.cpp -o customvector_realloc_bench && ./customvector_realloc_bench
+//      g++ -O2 -std=c++11 -I. -DCUSTOMVECTOR_NO_REALLOC benchmarks/customvector_realloc_bench.cpp -o customvector_realloc_bench_old && ./customvector_realloc_bench_old
+// every result is the best of 5 repeats in milliseconds (lower is better); it needs ~400 MB of ram at the peak;
+
+#include "_s2t_tools.h"
+#include <stdio.h>
+#include <vector>
+#include "_bench_tools.h"
+
+struct Vertex
+{
+    float x; float y; float u; float v;
+};
+
+// 64M of 32-bit pixels (256 MB) added one by one; every growth of full vector moves whole buffer;
+static double custom_push_back_pixels()
+{
+    return measure([](){
+        CustomVector<uint32_t> pixels(16,2);
+        for(uint32_t i = 0; i<64u*1024u*1024u; i++) pixels.push_back(i);
+        sink+=pixels[pixels.size()-1];
+    });
+}
+
+static double std_push_back_pixels()
+{
+    return measure([](){
+        std::vector<uint32_t> pixels;
+        for(uint32_t i = 0; i<64u*1024u*1024u; i++) pixels.push_back(i);
+        sink+=pixels[pixels.size()-1];
+    });
+}
+
+// vertex buffer filled to 1M and then reserved step by step up to 16M (256 MB) like a mesh that is loaded in chunks;
+static double custom_reserve_vertices()
+{
+    return measure([](){
+        CustomVector<Vertex> vertices(16,2);
+        for(uint32_t i = 0; i<1024u*1024u; i++) {Vertex vertex = {(float)i,0.0f,0.0f,0.0f}; vertices.push_back(vertex);}
+        for(size_t capacity = 2u*1024u*1024u; capacity<=16u*1024u*1024u; capacity+=1024u*1024u) vertices.reserve(capacity);
+        sink+=vertices.size();
+    });
+}
+
+static double std_reserve_vertices()
+{
+    return measure([](){
+        std::vector<Vertex> vertices;
+        for(uint32_t i = 0; i<1024u*1024u; i++) {Vertex vertex = {(float)i,0.0f,0.0f,0.0f}; vertices.push_back(vertex);}
+        for(size_t capacity = 2u*1024u*1024u; capacity<=16u*1024u*1024u; capacity+=1024u*1024u) vertices.reserve(capacity);
+        sink+=vertices.size();
+    });
+}
+
+// 32M pixels reserved, half of them used and memory trimmed with "shrink_to_fit()";
+static double custom_shrink_pixels()
+{
+    return measure([](){
+        CustomVector<uint32_t> pixels(16,2);
+        pixels.reserve(32u*1024u*1024u);
+        for(uint32_t i = 0; i<16u*1024u*1024u; i++) pixels.push_back(i);
+        pixels.shrink_to_fit();
+        sink+=pixels[pixels.size()-1];
+    });
+}
+
+static double std_shrink_pixels()
+{
+    return measure([](){
+        std::vector<uint32_t> pixels;
+        pixels.reserve(32u*1024u*1024u);
+        for(uint32_t i = 0; i<16u*1024u*1024u; i++) pixels.push_back(i);
+        pixels.shrink_to_fit();
+        sink+=pixels[pixels.size()-1];
+    });
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+#if defined(CUSTOMVECTOR_USE_REALLOC)
+    printf("CustomVector path: realloc()\n");
+#else
+    printf("CustomVector path: operator new + memcpy (CUSTOMVECTOR_NO_REALLOC)\n");
+#endif
+    printf("%-40s %14s %14s\n","case","CustomVector","std::vector");
+    printf("%-40s %11.1f ms %11.1f ms\n","push_back 64M uint32_t",custom_push_back_pixels(),std_push_back_pixels());
+    printf("%-40s %11.1f ms %11.1f ms\n","reserve 1M->16M Vertex in 1M steps",custom_reserve_vertices(),std_reserve_vertices());
+    printf("%-40s %11.1f ms %11.1f ms\n","shrink_to_fit 32M->16M uint32_t",custom_shrink_pixels(),std_shrink_pixels());
+    return 0;
+}
@@ -0,0 +1,77 @@
+// headless benchmark of frame pacing of "cSDL_FpsControl" for every pacing/scheduling mode at 60/144/240 fps;
+//      no window is opened; every frame "works" (spins) 20-50% of frame time (random) and then waits in "end_frame()";
+//      printed is jitter (|frame time - 1/fps|) p50/p99/max in microseconds and CPU use while waiting in "end_frame()"
+//          (CPU time/wall time of waiting; 100% == busy loop all the time);
+//      CPU time is read with std::clock() which is process time on Linux/macOS (on Windows it's wall time so CPU column means nothing there);
+// build and run (from main directory of repository); it takes ~25 seconds:
+//      g++ -O2 -std=c++11 -I. benchmarks/fps_pacing_bench.cpp -o fps_pacing_bench `sdl2-config --cflags --libs` -lSDL2_image && ./fps_pacing_bench
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+static double now_us()
+{
+    return (double)SDL_GetPerformanceCounter()*1000000.0/(double)SDL_GetPerformanceFrequency();
+}
+
+static void measure(uint32_t fps,cSDL_FpsControl::PacingMode pacing,cSDL_FpsControl::SchedulingMode scheduling,const char* name)
+{
+    cSDL_FpsControl fps_control(fps);
+    fps_control.change_pacing_mode(pacing);
+    fps_control.change_scheduling_mode(scheduling);
+
+    const uint32_t frames = fps*2;
+    const uint32_t warm_up_frames = 10;
+    const double target_us = 1000000.0/(double)fps;
+    std::vector<double> jitter;
+    double waiting_cpu_us = 0.0,waiting_wall_us = 0.0;
+
+    srand(1);
+    double last_frame_end = now_us();
+    for(uint32_t i = 0; i<frames; i++)
+    {
+        fps_control.start_frame();
+        const double work_us = target_us*(0.2+0.3*(double)(rand()%1000)/1000.0);
+        const double work_start = now_us();
+        while(now_us()-work_start<work_us);
+
+        const std::clock_t cpu_start = std::clock();
+        const double wait_start = now_us();
+        fps_control.end_frame();
+        const double frame_end = now_us();
+        waiting_cpu_us+=(double)(std::clock()-cpu_start)*1000000.0/(double)CLOCKS_PER_SEC;
+        waiting_wall_us+=frame_end-wait_start;
+
+        if(i>=warm_up_frames) jitter.push_back(fabs(frame_end-last_frame_end-target_us));
+        last_frame_end = frame_end;
+    }
+
+    std::sort(jitter.begin(),jitter.end());
+    printf("%5u %-26s %10.1f %10.1f %10.1f %9.1f%%\n",fps,name,jitter[jitter.size()/2],jitter[jitter.size()*99/100],jitter.back(),
+           (waiting_wall_us>0.0) ? waiting_cpu_us/waiting_wall_us*100.0 : 0.0);
+    return;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    SDL_Init(SDL_INIT_TIMER);
+    const uint32_t fps_list[3] = {60,144,240};
+    printf("%5s %-26s %10s %10s %10s %10s\n","fps","mode","p50 us","p99 us","max us","CPU wait");
+    for(int32_t f = 0; f<3; f++)
+    {
+        measure(fps_list[f],cSDL_FpsControl::PACING_DELAY,cSDL_FpsControl::SCHEDULING_RELATIVE,"delay/relative");
+        measure(fps_list[f],cSDL_FpsControl::PACING_SLEEP_SPIN,cSDL_FpsControl::SCHEDULING_RELATIVE,"sleep+spin/relative");
+        measure(fps_list[f],cSDL_FpsControl::PACING_DELAY,cSDL_FpsControl::SCHEDULING_ABSOLUTE,"delay/absolute");
+        measure(fps_list[f],cSDL_FpsControl::PACING_SLEEP_SPIN,cSDL_FpsControl::SCHEDULING_ABSOLUTE,"sleep+spin/absolute");
+    }
+    SDL_Quit();
+    return 0;
+}
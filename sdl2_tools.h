@@ -1,14 +1,25 @@
 #ifndef SDL2_HELP_LIBRARY_SECURITY_H
 #define SDL2_HELP_LIBRARY_SECURITY_H
 
-#include "_s2t_tools.h"	// CustomVector class
+#include "_s2t_tools.h"	// CustomVector,CustomIdMap & SmallCustomVector classes
 
 //declarations:
 //============================================================================================
+typedef Uint64 cSDL_Ticks;
+struct cSDL_TicksConverter;
+Uint64 cSDL_ticks_frequency();
+cSDL_Ticks cSDL_get_ticks();
+Uint64 cSDL_ticks_to_nanoseconds(cSDL_Ticks ticks);
+Uint64 cSDL_ticks_to_microseconds(cSDL_Ticks ticks);
+Uint64 cSDL_ticks_to_milliseconds(cSDL_Ticks ticks);
+cSDL_Ticks cSDL_nanoseconds_to_ticks(Uint64 nanoseconds);
+cSDL_Ticks cSDL_microseconds_to_ticks(Uint64 microseconds);
+cSDL_Ticks cSDL_milliseconds_to_ticks(Uint64 miliseconds);
 double cSDL_timer_high_precision();
 int32_t cSDL_load_streaming_texture(const char* const filename,SDL_Texture** output_texture,uint8_t** output_pixel_array,SDL_Renderer* render,uint32_t force_bytes_per_pixel,SDL_PixelFormatEnum force_pixelformat);
 class cSDL_FpsControl;
 class cSDL_MicroTimer;
+class cSDL_TimerScheduler;
 class cSDL_Anim3D_Yaxis;
 class cSDL_Anim3D_Xaxis;
 class cSDL_Anim3D_Xaxis_border;
@@ -21,13 +32,111 @@ class cSDL_AutomaticSlider;
 
 
 
+// "cSDL_Ticks" are ticks of SDL performance counter (SDL_GetPerformanceCounter()) and are the time base of all timers in this file;
+//  conversions are done only with integers so result is exact (rounded down) after any uptime (double loses precision of counter after ~100 days at 1GHz);
+//      ticks to ns/us/ms are multiplied by 128-bit fixed-point "unit/frequency" with 1 step of correction (~2x faster than 64-bit division
+//          and only few ns slower than double; reading of the counter itself costs more);
+//      without 128-bit integers (MSVC) whole seconds and the rest of ticks are divided separately ("ticks/frequency*unit+(ticks%frequency)*unit/frequency");
+//          define "CSDL_TICKS_NO_INT128" before including this file to use this division also with 128-bit integers;
+//      ns/us/ms to ticks are always divided like that; nothing overflows for frequencies up to ~18GHz (SDL gives 1GHz at most);
+//  differences of converted absolute times are exact to 1 unit and errors of rounding don't add up;
+Uint64 cSDL_ticks_frequency()
+{
+    static Uint64 frequency = SDL_GetPerformanceFrequency();
+    return frequency;
+}
+
+cSDL_Ticks cSDL_get_ticks()
+{
+    return SDL_GetPerformanceCounter();
+}
+
+#if defined(__SIZEOF_INT128__)&&!defined(CSDL_TICKS_NO_INT128)
+    #define CSDL_TICKS_USE_INT128
+#endif
+// converts ticks to "unit_per_second" units (1000 == miliseconds and so on); objects are made once for every unit by functions below;
+//      "frequency_of_timer" is frequency of ticks (frequency of SDL performance counter by default);
+struct cSDL_TicksConverter
+{
+    Uint64 unit;
+    Uint64 frequency;
+#if defined(CSDL_TICKS_USE_INT128)
+    Uint64 multiplier_high;     // floor(2^64*unit/frequency) == multiplier_high*2^64+multiplier_low;
+    Uint64 multiplier_low;
+#endif
+
+    cSDL_TicksConverter(Uint64 unit_per_second,Uint64 frequency_of_timer = cSDL_ticks_frequency())
+    {
+        this->unit = unit_per_second;
+        this->frequency = frequency_of_timer;
+#if defined(CSDL_TICKS_USE_INT128)
+        const unsigned __int128 multiplier = ((unsigned __int128)this->unit<<64)/this->frequency;
+        this->multiplier_high = (Uint64)(multiplier>>64);
+        this->multiplier_low = (Uint64)multiplier;
+#endif
+        return;
+    }
+
+    Uint64 convert(cSDL_Ticks ticks) const
+    {
+#if defined(CSDL_TICKS_USE_INT128)
+        // result can be lower by 1 'cause multiplier is rounded down so it's checked with rest of exact division;
+        Uint64 result = ticks*this->multiplier_high+(Uint64)(((unsigned __int128)ticks*this->multiplier_low)>>64);
+        const unsigned __int128 rest = (unsigned __int128)ticks*this->unit-(unsigned __int128)result*this->frequency;
+        if(rest>=this->frequency) result++;
+        return result;
+#else
+        return (ticks/this->frequency)*this->unit+((ticks%this->frequency)*this->unit)/this->frequency;
+#endif
+    }
+};
+
+Uint64 cSDL_ticks_to_nanoseconds(cSDL_Ticks ticks)
+{
+    static const cSDL_TicksConverter converter(1000000000);
+    return converter.convert(ticks);
+}
+
+Uint64 cSDL_ticks_to_microseconds(cSDL_Ticks ticks)
+{
+    static const cSDL_TicksConverter converter(1000000);
+    return converter.convert(ticks);
+}
+
+Uint64 cSDL_ticks_to_milliseconds(cSDL_Ticks ticks)
+{
+    static const cSDL_TicksConverter converter(1000);
+    return converter.convert(ticks);
+}
+
+cSDL_Ticks cSDL_nanoseconds_to_ticks(Uint64 nanoseconds)
+{
+    const Uint64 frequency = cSDL_ticks_frequency();
+    return (nanoseconds/1000000000)*frequency+((nanoseconds%1000000000)*frequency)/1000000000;
+}
+
+cSDL_Ticks cSDL_microseconds_to_ticks(Uint64 microseconds)
+{
+    const Uint64 frequency = cSDL_ticks_frequency();
+    return (microseconds/1000000)*frequency+((microseconds%1000000)*frequency)/1000000;
+}
+
+cSDL_Ticks cSDL_milliseconds_to_ticks(Uint64 miliseconds)
+{
+    const Uint64 frequency = cSDL_ticks_frequency();
+    return (miliseconds/1000)*frequency+((miliseconds%1000)*frequency)/1000;
+}
+
 // returns time in miliseconds (and even in nanoseconds before decimal numbers) which counts time from booting up OS;
 //  it's a more precise form of the SDL_GetTickCount() function;
+//  whole miliseconds are counted in integers so precision doesn't get worse with uptime (use "cSDL_get_ticks()" to not use double at all);
 double cSDL_timer_high_precision()
 {
-    static Uint64 frequency = SDL_GetPerformanceFrequency();
-    Uint64 counter = SDL_GetPerformanceCounter();
-    return (double)((double)counter/(double)frequency)*1000.0;
+    const Uint64 frequency = cSDL_ticks_frequency();
+    const cSDL_Ticks counter = cSDL_get_ticks();
+    const Uint64 miliseconds = cSDL_ticks_to_milliseconds(counter);
+    const Uint64 rest_of_ticks = counter-cSDL_milliseconds_to_ticks(miliseconds);    // ticks of the last not whole milisecond;
+    return (double)miliseconds+((double)rest_of_ticks*1000.0)/(double)frequency;
 }
 
 
@@ -129,7 +238,7 @@ int32_t cSDL_load_streaming_texture(const char* const filename,SDL_Texture** out
         for(int32_t y = 0; y!=h; y++) memcpy(&buffer[y*w*bytes_per_pixel],src+(y*img->pitch),expected_pitch);
     }
     else memcpy(buffer,img->pixels,w*h*bytes_per_pixel);
-    *output_pixel_array = (void*)buffer;
+    *output_pixel_array = buffer;
 
     SDL_FreeSurface(img);
 
@@ -155,20 +264,103 @@ int32_t cSDL_load_streaming_texture(const char* const filename,SDL_Texture** out
 //      stabilizes future frames makes future frame/frames has lower delay so as whole u will get stable 300 frames per second;
 //      so class is good for programs where u don't expect often fps drops below expected_fps/2;
 // this class needs more testing and cheking in good environment to check if class gives perfect results in every scenario;
+//
+// pacing mode "PACING_DELAY" (default) waits only with SDL_Delay() which sleeps in whole miliseconds (and OS can wake up later than that)
+//      so single frames can be ~1ms too long or too short (error is corrected in next frames);
+// pacing mode "PACING_SLEEP_SPIN" sleeps only to "spin margin" before the end of frame and then waits the rest in loop reading the timer
+//      so frames have precision of microseconds for cost of CPU time of this margin (see "change_spin_margin()");
+//      on Linux sleep is done with clock_nanosleep() to absolute time (so signals don't make it longer) and in other systems with SDL_Delay();
+//      define "CSDL_FPS_CONTROL_NO_NANOSLEEP" before including this file to always use SDL_Delay();
+//
+// scheduling mode "SCHEDULING_RELATIVE" (default) measures time from "start_frame()" to "end_frame()" and carries error to next frames like described above;
+// scheduling mode "SCHEDULING_ABSOLUTE" ends every frame at its own deadline counted in integer ticks of performance counter from the first frame
+//      (deadline of frame N == start + N*frequency/fps exactly; rest of division is carried) so errors of sleeping don't add up
+//      and after hours program is still in the same phase of expected fps; when frame ends after its deadline then catch-up policy decides:
+//          "CATCH_UP_COMPRESS" (default) - missed frames are done without waiting until program catches up to deadlines (if it's late more than 1 second then it's reset);
+//          "CATCH_UP_SKIP" - missed deadlines are skipped and program waits for the next deadline of the same grid (stays in phase but every late frame
+//              even by 1us makes next frame 1 period longer);
+//          "CATCH_UP_RESET" - deadlines start again from the end of late frame (phase is lost);
+//      precision of single frame still depends on pacing mode (SDL_Delay() of "PACING_DELAY" can end frame up to ~1ms before its deadline)
+//          so the best is "SCHEDULING_ABSOLUTE" with "PACING_SLEEP_SPIN";
+//
+// class keeps statistics of frames (frame time == time between the ends of 2 following "end_frame()"):
+//      ring buffer of "CSDL_FPS_CONTROL_STATS_FRAMES" last frame times (min/avg/max/p95/p99 of them from "get_frame_stats()"),
+//      histogram of all frame times with logarithmic buckets (4 buckets for every power of 2 of microseconds) and counts of late/skipped frames;
+//      nothing is allocated and there are no locks (statistics have to be read in the same thread that calls "end_frame()");
+//      "late" frame ended after its expected time (without waiting) and "skipped" frames are whole frames which program didn't catch up
+//          (relative mode drops them from correction; absolute mode with "CATCH_UP_SKIP"/"CATCH_UP_RESET" drops their deadlines);
+//      define "CSDL_FPS_CONTROL_STATS_FRAMES" (power of 2) before including this file to change size of ring buffer (256 by default);
+#ifndef CSDL_FPS_CONTROL_STATS_FRAMES
+    #define CSDL_FPS_CONTROL_STATS_FRAMES 256
+#endif
+#define CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS 124
+#if defined(__linux__)&&!defined(CSDL_FPS_CONTROL_NO_NANOSLEEP)
+    #define CSDL_FPS_CONTROL_USE_NANOSLEEP
+    #include <time.h>
+    #include <errno.h>
+#endif
 class cSDL_FpsControl
 {
+public:
+    enum PacingMode{PACING_DELAY,PACING_SLEEP_SPIN};
+    enum SchedulingMode{SCHEDULING_RELATIVE,SCHEDULING_ABSOLUTE};
+    enum CatchUpPolicy{CATCH_UP_COMPRESS,CATCH_UP_SKIP,CATCH_UP_RESET};
+
+    // all times in miliseconds; min/avg/max/p95/p99 are calculated from frames in ring buffer ("frames" of them);
+    struct FrameStats
+    {
+        double min_frame_time;
+        double avg_frame_time;
+        double max_frame_time;
+        double p95_frame_time;
+        double p99_frame_time;
+        uint32_t frames;
+        uint64_t all_frames;        // since creation or "reset_frame_stats()";
+        uint64_t late_frames;
+        uint64_t skipped_frames;
+    };
+
+private:
     Uint64 frequency_of_timer;
 
-    double fps_end;
-    double fps_start;
     uint32_t expected_fps;
-    float default_fps_delay;
-    double time_difference;
+    int64_t time_difference;        // in ticks; error of the last frame carried to the next one;
 
     double actual_fps;
 
+    PacingMode pacing_mode;
+    uint32_t spin_margin;   // in microseconds;
+
+    SchedulingMode scheduling_mode;
+    CatchUpPolicy catch_up_policy;
+    cSDL_Ticks frame_start_ticks;
+    cSDL_Ticks next_deadline;       // 0 == deadlines aren't started yet (they start from the next "start_frame()");
+    Uint64 frame_period_ticks;      // frequency/fps;
+    uint32_t frame_period_rest;     // frequency%fps;
+    uint32_t accumulated_rest;      // carried rest of division (always lower than fps);
+
+    static_assert((CSDL_FPS_CONTROL_STATS_FRAMES&(CSDL_FPS_CONTROL_STATS_FRAMES-1))==0,"CSDL_FPS_CONTROL_STATS_FRAMES has to be power of 2");
+    cSDL_Ticks last_frame_end_ticks;    // 0 == there was no frame yet;
+    uint32_t frame_times[CSDL_FPS_CONTROL_STATS_FRAMES];    // in microseconds;
+    uint32_t frame_times_count;
+    uint32_t frame_times_next;
+    uint64_t histogram[CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS];
+    uint64_t all_frames;
+    uint64_t late_frames;
+    uint64_t skipped_frames;
+
+    void _sleep_then_spin(cSDL_Ticks deadline);
+    void _wait_until(cSDL_Ticks deadline);
+    Uint64 _next_frame_period();
+    void _advance_deadline();
+    void _end_frame_relative();
+    void _end_frame_absolute();
+    void _reset_deadlines();
+    void _record_frame(cSDL_Ticks end_ticks);
+    static uint32_t _histogram_bucket(uint32_t microseconds);
+
 public:
-    cSDL_FpsControl(uint32_t fps);
+    cSDL_FpsControl(uint32_t fps);     // fps 0 is changed to 1 (also in "change_fps()");
 
     void end_frame();     //add at the end of loop;
     void start_frame();   //add at the the start of loop;
@@ -178,43 +370,105 @@ public:
     double get_actual_fps() const;
     uint32_t get_expected_fps() const;
 
+    // "PACING_DELAY" or "PACING_SLEEP_SPIN" (look at the description of the class);
+    void change_pacing_mode(PacingMode mode);
+    PacingMode get_pacing_mode() const;
+
+    // time in microseconds before the end of frame when "PACING_SLEEP_SPIN" stops sleeping and starts to spin (200 with clock_nanosleep() and 2000 with SDL_Delay() by default);
+    //      bigger margin == more precise frames if OS wakes up late but more CPU time used for spinning; 0 == only sleep;
+    void change_spin_margin(uint32_t microseconds);
+    uint32_t get_spin_margin() const;
+
+    // "SCHEDULING_RELATIVE" or "SCHEDULING_ABSOLUTE" (look at the description of the class); changing mode starts deadlines again;
+    void change_scheduling_mode(SchedulingMode mode);
+    SchedulingMode get_scheduling_mode() const;
+
+    // what "SCHEDULING_ABSOLUTE" does with frames which end after their deadline;
+    void change_catch_up_policy(CatchUpPolicy policy);
+    CatchUpPolicy get_catch_up_policy() const;
+
+    // statistics of last frames (look at the description of the class); all fields are 0 if there was no frame yet;
+    //      it sorts copy of ring buffer so it costs some microseconds but can be called every frame;
+    FrameStats get_frame_stats() const;
+    // time of the last frame in miliseconds (0.0 if there was no frame yet);
+    double get_last_frame_time() const;
+    uint64_t get_late_frames() const;
+    uint64_t get_skipped_frames() const;
+    // clears ring buffer,histogram and counters;
+    void reset_frame_stats();
+
+    // histogram has "CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS" buckets; bucket counts frames with time in range [start of bucket,start of the next bucket)
+    //      in microseconds (last bucket has also all longer frames);
+    uint64_t get_histogram_count(uint32_t bucket) const;
+    static uint32_t get_histogram_bucket_start(uint32_t bucket);
+
+    // writes to file csv with frame times from ring buffer (from the oldest) with header "frame,frame_time_us";
+    // returns 0 if no error occurs; returns -1 if file can't be opened; returns -2 if writing to file failed;
+    int32_t dump_frame_times_csv(const char* filename) const;
+    // writes to file csv with not empty buckets of histogram with header "bucket_start_us,bucket_end_us,count";
+    // returns 0 if no error occurs; returns -1 if file can't be opened; returns -2 if writing to file failed;
+    int32_t dump_histogram_csv(const char* filename) const;
+
 };
 
 cSDL_FpsControl::cSDL_FpsControl(uint32_t fps = 60)
 {
+    if(fps==0) fps = 1;     // the same as "change_fps()"; period of frame is frequency/fps;
     this->expected_fps = fps;
     this->actual_fps = fps;
-    this->default_fps_delay = (double)1000.0/fps;
-    this->frequency_of_timer = SDL_GetPerformanceFrequency();
-    this->time_difference = 0.0;
+    this->frequency_of_timer = cSDL_ticks_frequency();
+    this->time_difference = 0;
+    this->pacing_mode = PACING_DELAY;
+#if defined(CSDL_FPS_CONTROL_USE_NANOSLEEP)
+    this->spin_margin = 200;    // clock_nanosleep() usually wakes up ~50-100us late;
+#else
+    this->spin_margin = 2000;   // SDL_Delay() sleeps whole miliseconds;
+#endif
+    this->scheduling_mode = SCHEDULING_RELATIVE;
+    this->catch_up_policy = CATCH_UP_COMPRESS;
+    this->frame_start_ticks = 0;
+    this->_reset_deadlines();
+    this->reset_frame_stats();
     return;
 }
 
 void cSDL_FpsControl::end_frame()
 {
-    double actual_timer = ((double)SDL_GetPerformanceCounter()/this->frequency_of_timer)*1000.0;
+    if(this->scheduling_mode==SCHEDULING_ABSOLUTE) this->_end_frame_absolute();
+    else this->_end_frame_relative();
+
+    this->_record_frame(cSDL_get_ticks());
+    return;
+}
+
+void cSDL_FpsControl::_end_frame_relative()
+{
+    const cSDL_Ticks actual_ticks = cSDL_get_ticks();
+    const int64_t frame_period = (int64_t)this->_next_frame_period();
 
-    this->fps_end = (actual_timer-this->fps_start)+this->time_difference;
+    const int64_t frame_time = (int64_t)(actual_ticks-this->frame_start_ticks)+this->time_difference;
 
-    this->time_difference = 0.0;
-    if(this->default_fps_delay>this->fps_end)
+    this->time_difference = 0;
+    if(frame_period>frame_time)
     {
         this->actual_fps = (double)this->expected_fps;
 
-        double actual_delay = this->default_fps_delay-this->fps_end;
-        SDL_Delay((uint32_t)actual_delay);
-        actual_timer = (((double)SDL_GetPerformanceCounter()/this->frequency_of_timer)*1000.0)-actual_timer;
+        const int64_t actual_delay = frame_period-frame_time;
+        if(this->pacing_mode==PACING_SLEEP_SPIN) this->_sleep_then_spin(actual_ticks+(Uint64)actual_delay);
+        else SDL_Delay((uint32_t)cSDL_ticks_to_milliseconds((cSDL_Ticks)actual_delay));
 
-        this->time_difference = actual_timer-actual_delay;
+        this->time_difference = (int64_t)(cSDL_get_ticks()-actual_ticks)-actual_delay;
     }
     else
     {
-        this->time_difference = this->fps_end-this->default_fps_delay;
+        this->late_frames++;
+        this->time_difference = frame_time-frame_period;
 
-        if(this->time_difference>this->default_fps_delay)
+        if(this->time_difference>frame_period)
         {
-            this->actual_fps = (double)1000.0/this->fps_end;
-            this->time_difference = 0.0;
+            this->actual_fps = (double)this->frequency_of_timer/(double)frame_time;
+            this->skipped_frames += (uint64_t)(this->time_difference/frame_period);
+            this->time_difference = 0;
 
         } else this->actual_fps = (double)this->expected_fps;
     }
@@ -224,7 +478,7 @@ void cSDL_FpsControl::end_frame()
 
 void cSDL_FpsControl::start_frame()
 {
-    fps_start = ((double)SDL_GetPerformanceCounter()/this->frequency_of_timer)*1000.0;
+    this->frame_start_ticks = cSDL_get_ticks();
     return;
 }
 
@@ -232,8 +486,8 @@ void cSDL_FpsControl::change_fps(uint32_t fps)
 {
     if(fps==0) fps = 1;
     this->expected_fps = fps;
-    this->default_fps_delay = (double)1000.0/fps;
-    this->time_difference = 0.0;
+    this->time_difference = 0;
+    this->_reset_deadlines();
     return;
 }
 
@@ -246,22 +500,339 @@ uint32_t cSDL_FpsControl::get_expected_fps() const
     return this->expected_fps;
 }
 
+void cSDL_FpsControl::change_pacing_mode(PacingMode mode)
+{
+    this->pacing_mode = mode;
+    this->time_difference = 0;
+    return;
+}
+
+cSDL_FpsControl::PacingMode cSDL_FpsControl::get_pacing_mode() const
+{
+    return this->pacing_mode;
+}
+
+void cSDL_FpsControl::change_spin_margin(uint32_t microseconds)
+{
+    this->spin_margin = microseconds;
+    return;
+}
+
+uint32_t cSDL_FpsControl::get_spin_margin() const
+{
+    return this->spin_margin;
+}
+
+void cSDL_FpsControl::change_scheduling_mode(SchedulingMode mode)
+{
+    this->scheduling_mode = mode;
+    this->time_difference = 0;
+    this->_reset_deadlines();
+    return;
+}
+
+cSDL_FpsControl::SchedulingMode cSDL_FpsControl::get_scheduling_mode() const
+{
+    return this->scheduling_mode;
+}
+
+void cSDL_FpsControl::change_catch_up_policy(CatchUpPolicy policy)
+{
+    this->catch_up_policy = policy;
+    return;
+}
+
+cSDL_FpsControl::CatchUpPolicy cSDL_FpsControl::get_catch_up_policy() const
+{
+    return this->catch_up_policy;
+}
+
+void cSDL_FpsControl::_reset_deadlines()
+{
+    this->next_deadline = 0;
+    this->accumulated_rest = 0;
+    this->frame_period_ticks = this->frequency_of_timer/this->expected_fps;
+    this->frame_period_rest = (uint32_t)(this->frequency_of_timer%this->expected_fps);
+    return;
+}
+
+// length of the next frame in ticks; rest of "frequency/fps" is added as 1 tick every time it sums up to whole tick
+//      so "fps" following frames take exactly 1 second;
+Uint64 cSDL_FpsControl::_next_frame_period()
+{
+    this->accumulated_rest += this->frame_period_rest;
+    if(this->accumulated_rest>=this->expected_fps)
+    {
+        this->accumulated_rest -= this->expected_fps;
+        return this->frame_period_ticks+1;
+    }
+    return this->frame_period_ticks;
+}
+
+// moves deadline by exactly 1 frame;
+void cSDL_FpsControl::_advance_deadline()
+{
+    this->next_deadline += this->_next_frame_period();
+    return;
+}
+
+void cSDL_FpsControl::_end_frame_absolute()
+{
+    if(this->next_deadline==0)
+    {
+        this->next_deadline = this->frame_start_ticks;
+        if(this->next_deadline==0) this->next_deadline = cSDL_get_ticks();   // "start_frame()" wasn't called;
+        this->_advance_deadline();
+    }
+
+    const cSDL_Ticks actual_ticks = cSDL_get_ticks();
+    if(actual_ticks<this->next_deadline)
+    {
+        this->actual_fps = (double)this->expected_fps;
+        this->_wait_until(this->next_deadline);
+        this->_advance_deadline();
+        return;
+    }
+
+    // frame is late;
+    this->late_frames++;
+    if(actual_ticks>this->frame_start_ticks) this->actual_fps = (double)this->frequency_of_timer/(double)(actual_ticks-this->frame_start_ticks);
+    else this->actual_fps = (double)this->expected_fps;
+
+    if(this->catch_up_policy==CATCH_UP_COMPRESS&&actual_ticks-this->next_deadline<this->frequency_of_timer)
+    {
+        this->_advance_deadline();      // next frame starts now without waiting;
+        return;
+    }
+    if(this->catch_up_policy==CATCH_UP_SKIP)
+    {
+        const Uint64 missed_frames = (actual_ticks-this->next_deadline)/(this->frame_period_ticks+1);   // lower estimate so loop does at most few steps;
+        for(Uint64 i = 0; i!=missed_frames; i++) this->_advance_deadline();
+        this->skipped_frames += missed_frames;
+        while(this->next_deadline<=actual_ticks)
+        {
+            this->_advance_deadline();
+            this->skipped_frames++;
+        }
+        this->_wait_until(this->next_deadline);
+        this->_advance_deadline();
+        return;
+    }
+
+    // CATCH_UP_RESET (or CATCH_UP_COMPRESS late more than 1 second);
+    this->skipped_frames += (actual_ticks-this->next_deadline)/(this->frame_period_ticks+1);
+    this->accumulated_rest = 0;
+    this->next_deadline = actual_ticks;
+    this->_advance_deadline();
+    return;
+}
+
+void cSDL_FpsControl::_record_frame(cSDL_Ticks end_ticks)
+{
+    if(this->last_frame_end_ticks!=0&&end_ticks>this->last_frame_end_ticks)
+    {
+        Uint64 microseconds = cSDL_ticks_to_microseconds(end_ticks-this->last_frame_end_ticks);
+        if(microseconds>0xFFFFFFFF) microseconds = 0xFFFFFFFF;
+
+        this->frame_times[this->frame_times_next] = (uint32_t)microseconds;
+        this->frame_times_next = (this->frame_times_next+1)&(CSDL_FPS_CONTROL_STATS_FRAMES-1);
+        if(this->frame_times_count!=CSDL_FPS_CONTROL_STATS_FRAMES) this->frame_times_count++;
+        this->histogram[_histogram_bucket((uint32_t)microseconds)]++;
+        this->all_frames++;
+    }
+    this->last_frame_end_ticks = end_ticks;
+    return;
+}
+
+// 4 buckets for every power of 2: bucket of "2^n+k*2^(n-2)" is 4*(n-1)+k (values lower than 4 have own buckets 0-3);
+uint32_t cSDL_FpsControl::_histogram_bucket(uint32_t microseconds)
+{
+    if(microseconds<4) return microseconds;
+    uint32_t power = 31;
+    while((microseconds>>power)==0) power--;
+    return (power-1)*4+((microseconds>>(power-2))&3);
+}
+
+uint32_t cSDL_FpsControl::get_histogram_bucket_start(uint32_t bucket)
+{
+    if(bucket<4) return bucket;
+    if(bucket>=CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS) bucket = CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS-1;
+    const uint32_t power = bucket/4+1;
+    return (1u<<power)+((bucket&3)<<(power-2));
+}
+
+uint64_t cSDL_FpsControl::get_histogram_count(uint32_t bucket) const
+{
+    if(bucket>=CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS) return 0;
+    return this->histogram[bucket];
+}
+
+cSDL_FpsControl::FrameStats cSDL_FpsControl::get_frame_stats() const
+{
+    FrameStats stats;
+    memset(&stats,0,sizeof(FrameStats));
+    stats.all_frames = this->all_frames;
+    stats.late_frames = this->late_frames;
+    stats.skipped_frames = this->skipped_frames;
+    stats.frames = this->frame_times_count;
+    if(this->frame_times_count==0) return stats;
+
+    // insertion sort of copy; ring buffer is small and almost sorted data is sorted quickly anyway;
+    uint32_t sorted[CSDL_FPS_CONTROL_STATS_FRAMES];
+    uint64_t sum = 0;
+    for(uint32_t i = 0; i!=this->frame_times_count; i++)
+    {
+        const uint32_t value = this->frame_times[i];
+        sum += value;
+        uint32_t j = i;
+        while(j>0&&sorted[j-1]>value)
+        {
+            sorted[j] = sorted[j-1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    const uint32_t count = this->frame_times_count;
+    stats.min_frame_time = sorted[0]/1000.0;
+    stats.max_frame_time = sorted[count-1]/1000.0;
+    stats.avg_frame_time = ((double)sum/count)/1000.0;
+    stats.p95_frame_time = sorted[((uint64_t)(count-1)*95)/100]/1000.0;
+    stats.p99_frame_time = sorted[((uint64_t)(count-1)*99)/100]/1000.0;
+    return stats;
+}
+
+double cSDL_FpsControl::get_last_frame_time() const
+{
+    if(this->frame_times_count==0) return 0.0;
+    return this->frame_times[(this->frame_times_next+CSDL_FPS_CONTROL_STATS_FRAMES-1)&(CSDL_FPS_CONTROL_STATS_FRAMES-1)]/1000.0;
+}
+
+uint64_t cSDL_FpsControl::get_late_frames() const
+{
+    return this->late_frames;
+}
+
+uint64_t cSDL_FpsControl::get_skipped_frames() const
+{
+    return this->skipped_frames;
+}
+
+void cSDL_FpsControl::reset_frame_stats()
+{
+    this->last_frame_end_ticks = 0;
+    this->frame_times_count = 0;
+    this->frame_times_next = 0;
+    memset(this->histogram,0,sizeof(this->histogram));
+    this->all_frames = 0;
+    this->late_frames = 0;
+    this->skipped_frames = 0;
+    return;
+}
+
+int32_t cSDL_FpsControl::dump_frame_times_csv(const char* filename) const
+{
+    SDL_RWops* file = SDL_RWFromFile(filename,"w");
+    if(file==NULL) return -1;
+
+    char line[64];
+    int32_t length = SDL_snprintf(line,sizeof(line),"frame,frame_time_us\n");
+    bool error = (SDL_RWwrite(file,line,1,length)!=(size_t)length);
+
+    const uint32_t first = (this->frame_times_next+CSDL_FPS_CONTROL_STATS_FRAMES-this->frame_times_count)&(CSDL_FPS_CONTROL_STATS_FRAMES-1);
+    for(uint32_t i = 0; i!=this->frame_times_count&&error==0; i++)
+    {
+        length = SDL_snprintf(line,sizeof(line),"%u,%u\n",i,this->frame_times[(first+i)&(CSDL_FPS_CONTROL_STATS_FRAMES-1)]);
+        error = (SDL_RWwrite(file,line,1,length)!=(size_t)length);
+    }
+
+    if(SDL_RWclose(file)!=0) error = 1;
+    return (error==1) ? -2 : 0;
+}
+
+int32_t cSDL_FpsControl::dump_histogram_csv(const char* filename) const
+{
+    SDL_RWops* file = SDL_RWFromFile(filename,"w");
+    if(file==NULL) return -1;
+
+    char line[96];
+    int32_t length = SDL_snprintf(line,sizeof(line),"bucket_start_us,bucket_end_us,count\n");
+    bool error = (SDL_RWwrite(file,line,1,length)!=(size_t)length);
+
+    for(uint32_t i = 0; i!=CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS&&error==0; i++)
+    {
+        if(this->histogram[i]==0) continue;
+        const uint32_t end = (i+1<CSDL_FPS_CONTROL_HISTOGRAM_BUCKETS) ? get_histogram_bucket_start(i+1) : 0xFFFFFFFF;
+        length = SDL_snprintf(line,sizeof(line),"%u,%u,%llu\n",get_histogram_bucket_start(i),end,(unsigned long long)this->histogram[i]);
+        error = (SDL_RWwrite(file,line,1,length)!=(size_t)length);
+    }
+
+    if(SDL_RWclose(file)!=0) error = 1;
+    return (error==1) ? -2 : 0;
+}
+
+// waits to "deadline" in ticks of performance counter with actual pacing mode;
+void cSDL_FpsControl::_wait_until(cSDL_Ticks deadline)
+{
+    if(this->pacing_mode==PACING_SLEEP_SPIN)
+    {
+        this->_sleep_then_spin(deadline);
+        return;
+    }
+
+    const cSDL_Ticks actual_ticks = cSDL_get_ticks();
+    if(deadline>actual_ticks) SDL_Delay((uint32_t)cSDL_ticks_to_milliseconds(deadline-actual_ticks));
+    return;
+}
+
+// "deadline" in ticks of performance counter; sleeps coarsely to "spin_margin" before the end and spins the rest;
+void cSDL_FpsControl::_sleep_then_spin(cSDL_Ticks deadline)
+{
+    const cSDL_Ticks start = cSDL_get_ticks();
+    if(deadline<=start) return;
+    const cSDL_Ticks delay_ticks = deadline-start;
+    const cSDL_Ticks margin_ticks = cSDL_microseconds_to_ticks(this->spin_margin);
+
+    if(delay_ticks>margin_ticks)
+    {
+        const cSDL_Ticks sleep_ticks = delay_ticks-margin_ticks;
+#if defined(CSDL_FPS_CONTROL_USE_NANOSLEEP)
+        // performance counter of SDL can be different clock than CLOCK_MONOTONIC so only length of sleep is taken from it;
+        const Uint64 sleep_ns = cSDL_ticks_to_nanoseconds(sleep_ticks);
+        timespec wake_up;
+        clock_gettime(CLOCK_MONOTONIC,&wake_up);
+        wake_up.tv_sec += (time_t)(sleep_ns/1000000000);
+        wake_up.tv_nsec += (long)(sleep_ns%1000000000);
+        if(wake_up.tv_nsec>=1000000000)
+        {
+            wake_up.tv_nsec -= 1000000000;
+            wake_up.tv_sec++;
+        }
+        while(clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&wake_up,NULL)==EINTR);
+#else
+        SDL_Delay((uint32_t)cSDL_ticks_to_milliseconds(sleep_ticks));
+#endif
+    }
+
+    while(cSDL_get_ticks()<deadline);
+    return;
+}
+
 
 
 // #include <SDL2/SDL.h>
 // #include <stdint.h>
 //      timer in precision to microseconds;
+//      time is taken from "cSDL_get_ticks()" and converted to microseconds only with integers so it doesn't lose precision after long uptime;
 class cSDL_MicroTimer
 {
     uint64_t internal_timer;
-    uint64_t past_time;
+    uint64_t past_time;     // in microseconds from "cSDL_ticks_to_microseconds()";
     uint64_t previous_time_rest;
 
-    uint64_t frequency;
-
 public:
 
-    cSDL_MicroTimer(){this->frequency = SDL_GetPerformanceFrequency(); this->internal_timer = 0; this->previous_time_rest = 0; return;}
+    cSDL_MicroTimer(){this->internal_timer = 0; this->previous_time_rest = 0; return;}
 
 // 1000 microseconds == 1 milisecond;
     void set_internal_timer(uint64_t delay_in_microseconds);
@@ -278,14 +849,14 @@ void cSDL_MicroTimer::set_internal_timer(uint64_t delay_in_microseconds)
 {
     if(delay_in_microseconds==0) return;
     this->internal_timer = delay_in_microseconds;
-    this->past_time = (uint64_t)(((double)SDL_GetPerformanceCounter()/(double)this->frequency)*1000000);
+    this->past_time = cSDL_ticks_to_microseconds(cSDL_get_ticks());
     return;
 }
 
 uint64_t cSDL_MicroTimer::run_timer()
 {
     if(this->internal_timer==0) return 0;
-    uint64_t actual_time = (uint64_t)(((double)SDL_GetPerformanceCounter()/(double)this->frequency)*1000000);
+    uint64_t actual_time = cSDL_ticks_to_microseconds(cSDL_get_ticks());
     uint64_t accumulated_delay = (actual_time-this->past_time)+this->previous_time_rest;
 
     if(accumulated_delay>=this->internal_timer)
@@ -302,82 +873,332 @@ uint64_t cSDL_MicroTimer::run_timer()
 
 void cSDL_MicroTimer::reset_accumulated_timer()
 {
-    this->past_time = (uint64_t)(((double)SDL_GetPerformanceCounter()/(double)this->frequency)*1000000);
+    this->past_time = cSDL_ticks_to_microseconds(cSDL_get_ticks());
     this->previous_time_rest = 0;
     return;
 }
 
-//      cSDL class for 3D animation that flips around Y axis;
-// #include <SDL/SDL2.h>
-// #include <math.h>
+// #include <SDL2/SDL.h>
 // #include <stdint.h>
-class cSDL_Anim3D_Yaxis
+// needs classes "CustomVector" & "CustomIdMap";
+//      scheduler of many timers in precision to microseconds (periodic like "cSDL_MicroTimer" and one-shot) kept in binary min-heap by their deadlines;
+//      "run_timers()" reads performance counter only once for all timers and returns only timers which ended with number of times they ended
+//          (rest of time is carried like in "cSDL_MicroTimer" so periodic timers don't drift);
+//      cost of "run_timers()" is O(1) if no timer ended and O(log n) for every ended timer; creating/deleting/changing timer is O(log n);
+class cSDL_TimerScheduler
 {
 public:
-    enum AnimationSpeedType{SPEED_LINEAR,SPEED_COS};
-    enum ScalingType{CENTERED_SCALING,RAW_SCALING};
+    struct ExpiredTimer
+    {
+        uint32_t id;
+        uint32_t user_custom_data;
+        uint64_t count;     // number of times timer ended since the last "run_timers()" (always 1 for one-shot timer);
+    };
 
 private:
-    int32_t _original_images_h;
-    int32_t _original_images_w;
-    SDL_Texture* _front_image;
-    SDL_Texture* _back_image;
-    float _speed;
-    AnimationSpeedType _speed_type;
+    struct Timer
+    {
+        uint64_t deadline;  // in microseconds from "cSDL_ticks_to_microseconds()";
+        uint64_t delay;     // in microseconds;
+        uint32_t id;
+        uint32_t user_custom_data;
+        bool one_shot;
+    };
 
-//  "_main_execute_animation()" mathematic variables;
-    bool _half_flip;
-    bool _whole_flip;
-    SDL_Texture* _pointer_image;
-    double _rotate_y_variable;
-    bool _direction;
+    CustomVector<Timer> _heap;              // heap[0] has the nearest deadline; children of "i" are "2*i+1" and "2*i+2";
+    CustomIdMap _timers_id_map;             // "id" of timer -> index in "_heap"; it's kept in sync with every move of timer in heap;
+    CustomVector<ExpiredTimer> _expired;    // result of the last "run_timers()";
+    uint32_t _oryginal_timer_id;            // this variable only increasing its value; it's for creating "id" for "Timer";
 
-// "execute_animation()" & "execute_animation_draw()" mathematic variables;
-    ScalingType _scaling_type;
-    float _scaling;
+    uint32_t _add_timer(uint64_t delay_in_microseconds,bool one_shot,uint32_t user_custom_data);
+    void _place_timer(size_t index,const Timer& timer);
+    size_t _sift_up(size_t index);
+    void _sift_down(size_t index);
+    void _update_timer(size_t index);
+    void _remove_timer(size_t index);
 
 public:
-// "front_image" pointer to the front of the main image;
-// "back_image" pointer to the back of the main image;
-// "original_images_h" height of images in "front_image" and "back_image"; both images should have the same height;
-// "original_images_w" width of images in "front_image" and "back_image"; both images should have the same width;
-// "speed" speed of animation in float; number should be above 0.0;
-// "speed_type" speed type;
-// while using this class,u shouldn't free memory from pointers passed to "front_image","back_image";
-//      also class doesn't free passed pointers so u have to do it yourself;
-    cSDL_Anim3D_Yaxis(SDL_Texture* front_image,SDL_Texture* back_image,int32_t original_images_h,int32_t original_images_w,
-                      float speed,AnimationSpeedType speed_type);
-
-//      that's main function; it's should be executed for every frame in program;
-// "io_rect" it's main variable on which class operates; "w" and "h" will be changed entirely after running this function;
-//      to "x"/"y" are only added some numbers so there is a sense in setting beforehand these variables before passing them to this func;
-// "actual_fps" should have actual updated application fps; shouldn't be below 1;
-//      this variable is here for synchronization reasons for speeding up or down animation; variable can be static if u want;
-// returns changed "io_rect"; in specific: to "y" & "x" are added some number,"h" and "w" are totaly changed;
-// also returns pointer to "out_image_pointer" of texture that should be displayed in animation:
-    void execute_animation(SDL_Texture** out_image_pointer,SDL_Rect* io_rect,uint32_t actual_fps);
-//      it's the same function as "execute_animation" except it's additionally draws animation into render;
-    void execute_animation_draw(SDL_Rect* io_rect,uint32_t actual_fps,SDL_Renderer* render);
+    cSDL_TimerScheduler();
+
+// creates timer which ends every "delay_in_microseconds" (like "set_internal_timer()" of "cSDL_MicroTimer");
+// returns "id" of timer; returns 0 if "delay_in_microseconds" == 0;
+    uint32_t create_timer(uint64_t delay_in_microseconds,uint32_t user_custom_data);
+// creates timer which ends only once after "delay_in_microseconds" and then is deleted;
+// returns "id" of timer; returns 0 if "delay_in_microseconds" == 0;
+    uint32_t create_one_shot_timer(uint64_t delay_in_microseconds,uint32_t user_custom_data);
+
+// does nothing if timer with this "id" doesn't exist (also one-shot timer which already ended);
+    void delete_timer(uint32_t id);
+// timer starts counting from now and its accumulated time is dropped (like "reset_accumulated_timer()" of "cSDL_MicroTimer");
+    void reset_timer(uint32_t id);
+// changes delay of timer and starts counting from now; "delay_in_microseconds" == 0 is ignored;
+    void change_timer_delay(uint32_t id,uint64_t delay_in_microseconds);
+// deletes every timer;
+    void clear();
+
+// reads performance counter once and returns timers which ended since the last call (ordered by their deadlines);
+//      returned vector is valid until the next call of "run_timers()";
+    const CustomVector<ExpiredTimer>& run_timers();
+// the same but with time read before by "cSDL_get_ticks()" (for example once per frame for many schedulers);
+    const CustomVector<ExpiredTimer>& run_timers(cSDL_Ticks actual_ticks);
+
+    size_t get_timers_count() const;
+// returns microseconds to the nearest deadline (0 if some timer already ended); returns 0xFFFFFFFFFFFFFFFF if there are no timers;
+    uint64_t get_time_to_next_timer() const;
+};
 
-//      changes "original_images_h" & "original_images_w";
-// if u don't want to change some variable,just place there -1;
-    void change_images_original_w_h(int32_t original_images_h,int32_t original_images_w);
+cSDL_TimerScheduler::cSDL_TimerScheduler()
+{
+    this->_oryginal_timer_id = 1;
+    return;
+}
 
-//      adds number to actual scalling variable;
-    void change_scaling_dynamically(float scaling);
-//      swaps actual scaling variable inside class with this one;
-// "scaling" should be above 0.0;
-    void change_scaling(float scaling);
-    void change_scaling_type(ScalingType scaling_type);
+uint32_t cSDL_TimerScheduler::create_timer(uint64_t delay_in_microseconds,uint32_t user_custom_data = 0)
+{
+    if(delay_in_microseconds==0) return 0;
+    return this->_add_timer(delay_in_microseconds,0,user_custom_data);
+}
 
-// number should be above 0.0;
-    void change_speed(float speed);
-    void change_speed_dynamically(float speed);
-// if "left_or_right" == 0 then direction will be left; else if 1 then will be right;
-    void change_direction(bool left_or_right);
+uint32_t cSDL_TimerScheduler::create_one_shot_timer(uint64_t delay_in_microseconds,uint32_t user_custom_data = 0)
+{
+    if(delay_in_microseconds==0) return 0;
+    return this->_add_timer(delay_in_microseconds,1,user_custom_data);
+}
 
-    void change_image_front(SDL_Texture* front_image);
-    void change_image_back(SDL_Texture* back_image);
+void cSDL_TimerScheduler::delete_timer(uint32_t id)
+{
+    const uint32_t index = this->_timers_id_map.find(id);
+    if(index==0xFFFFFFFF) return;
+    this->_remove_timer(index);
+    return;
+}
+
+void cSDL_TimerScheduler::reset_timer(uint32_t id)
+{
+    const uint32_t index = this->_timers_id_map.find(id);
+    if(index==0xFFFFFFFF) return;
+    this->_heap[index].deadline = cSDL_ticks_to_microseconds(cSDL_get_ticks())+this->_heap[index].delay;
+    this->_update_timer(index);
+    return;
+}
+
+void cSDL_TimerScheduler::change_timer_delay(uint32_t id,uint64_t delay_in_microseconds)
+{
+    if(delay_in_microseconds==0) return;
+    const uint32_t index = this->_timers_id_map.find(id);
+    if(index==0xFFFFFFFF) return;
+    this->_heap[index].delay = delay_in_microseconds;
+    this->_heap[index].deadline = cSDL_ticks_to_microseconds(cSDL_get_ticks())+delay_in_microseconds;
+    this->_update_timer(index);
+    return;
+}
+
+void cSDL_TimerScheduler::clear()
+{
+    this->_heap.clear();
+    this->_timers_id_map.clear();
+    this->_expired.clear();
+    return;
+}
+
+const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& cSDL_TimerScheduler::run_timers()
+{
+    return this->run_timers(cSDL_get_ticks());
+}
+
+const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& cSDL_TimerScheduler::run_timers(cSDL_Ticks actual_ticks)
+{
+    this->_expired.resize(0);   // memory is kept for the next calls;
+    const uint64_t actual_time = cSDL_ticks_to_microseconds(actual_ticks);
+
+    // every ended timer gets deadline after "actual_time" (or is removed) so it's taken from the top only once;
+    while(this->_heap.size()!=0&&this->_heap[0].deadline<=actual_time)
+    {
+        Timer& timer = this->_heap[0];
+        ExpiredTimer expired;
+        expired.id = timer.id;
+        expired.user_custom_data = timer.user_custom_data;
+
+        if(timer.one_shot==1)
+        {
+            expired.count = 1;
+            this->_expired.push_back(expired);
+            this->_remove_timer(0);
+            continue;
+        }
+
+        // the same as "whole_numbers" and "previous_time_rest" of "cSDL_MicroTimer": deadlines stay on grid of "delay" from the start;
+        expired.count = (actual_time-timer.deadline)/timer.delay+1;
+        timer.deadline += expired.count*timer.delay;
+        this->_expired.push_back(expired);
+        this->_sift_down(0);
+    }
+
+    return this->_expired;
+}
+
+size_t cSDL_TimerScheduler::get_timers_count() const
+{
+    return this->_heap.size();
+}
+
+uint64_t cSDL_TimerScheduler::get_time_to_next_timer() const
+{
+    if(this->_heap.size()==0) return 0xFFFFFFFFFFFFFFFF;
+    const uint64_t actual_time = cSDL_ticks_to_microseconds(cSDL_get_ticks());
+    if(this->_heap[0].deadline<=actual_time) return 0;
+    return this->_heap[0].deadline-actual_time;
+}
+
+uint32_t cSDL_TimerScheduler::_add_timer(uint64_t delay_in_microseconds,bool one_shot,uint32_t user_custom_data)
+{
+    Timer timer;
+    timer.deadline = cSDL_ticks_to_microseconds(cSDL_get_ticks())+delay_in_microseconds;
+    timer.delay = delay_in_microseconds;
+    timer.id = this->_oryginal_timer_id;
+    timer.user_custom_data = user_custom_data;
+    timer.one_shot = one_shot;
+    this->_oryginal_timer_id++;
+
+    this->_heap.push_back(timer);
+    this->_timers_id_map.insert(timer.id,this->_heap.size()-1);
+    this->_sift_up(this->_heap.size()-1);
+    return timer.id;
+}
+
+// writes timer to "index" of heap and updates its index in "_timers_id_map";
+void cSDL_TimerScheduler::_place_timer(size_t index,const Timer& timer)
+{
+    this->_heap[index] = timer;
+    this->_timers_id_map.insert(timer.id,index);
+    return;
+}
+
+// returns new index of timer;
+size_t cSDL_TimerScheduler::_sift_up(size_t index)
+{
+    const Timer timer = this->_heap[index];
+    while(index>0)
+    {
+        const size_t parent = (index-1)/2;
+        if(this->_heap[parent].deadline<=timer.deadline) break;
+        this->_place_timer(index,this->_heap[parent]);
+        index = parent;
+    }
+    this->_place_timer(index,timer);
+    return index;
+}
+
+void cSDL_TimerScheduler::_sift_down(size_t index)
+{
+    const size_t count = this->_heap.size();
+    const Timer timer = this->_heap[index];
+    for(;;)
+    {
+        size_t child = index*2+1;
+        if(child>=count) break;
+        if(child+1<count&&this->_heap[child+1].deadline<this->_heap[child].deadline) child++;
+        if(timer.deadline<=this->_heap[child].deadline) break;
+        this->_place_timer(index,this->_heap[child]);
+        index = child;
+    }
+    this->_place_timer(index,timer);
+    return;
+}
+
+// puts timer with changed deadline to the right place of heap;
+void cSDL_TimerScheduler::_update_timer(size_t index)
+{
+    if(this->_sift_up(index)==index) this->_sift_down(index);
+    return;
+}
+
+// last timer of heap is moved to place of removed one;
+void cSDL_TimerScheduler::_remove_timer(size_t index)
+{
+    this->_timers_id_map.erase(this->_heap[index].id);
+    const size_t last = this->_heap.size()-1;
+    if(index!=last)
+    {
+        this->_place_timer(index,this->_heap[last]);
+        this->_heap.pop_back();
+        this->_update_timer(index);
+    }
+    else this->_heap.pop_back();
+    return;
+}
+
+//      cSDL class for 3D animation that flips around Y axis;
+// #include <SDL/SDL2.h>
+// #include <math.h>
+// #include <stdint.h>
+class cSDL_Anim3D_Yaxis
+{
+public:
+    enum AnimationSpeedType{SPEED_LINEAR,SPEED_COS};
+    enum ScalingType{CENTERED_SCALING,RAW_SCALING};
+
+private:
+    int32_t _original_images_h;
+    int32_t _original_images_w;
+    SDL_Texture* _front_image;
+    SDL_Texture* _back_image;
+    float _speed;
+    AnimationSpeedType _speed_type;
+
+//  "_main_execute_animation()" mathematic variables;
+    bool _half_flip;
+    bool _whole_flip;
+    SDL_Texture* _pointer_image;
+    double _rotate_y_variable;
+    bool _direction;
+
+// "execute_animation()" & "execute_animation_draw()" mathematic variables;
+    ScalingType _scaling_type;
+    float _scaling;
+
+public:
+// "front_image" pointer to the front of the main image;
+// "back_image" pointer to the back of the main image;
+// "original_images_h" height of images in "front_image" and "back_image"; both images should have the same height;
+// "original_images_w" width of images in "front_image" and "back_image"; both images should have the same width;
+// "speed" speed of animation in float; number should be above 0.0;
+// "speed_type" speed type;
+// while using this class,u shouldn't free memory from pointers passed to "front_image","back_image";
+//      also class doesn't free passed pointers so u have to do it yourself;
+    cSDL_Anim3D_Yaxis(SDL_Texture* front_image,SDL_Texture* back_image,int32_t original_images_h,int32_t original_images_w,
+                      float speed,AnimationSpeedType speed_type);
+
+//      that's main function; it's should be executed for every frame in program;
+// "io_rect" it's main variable on which class operates; "w" and "h" will be changed entirely after running this function;
+//      to "x"/"y" are only added some numbers so there is a sense in setting beforehand these variables before passing them to this func;
+// "actual_fps" should have actual updated application fps; shouldn't be below 1;
+//      this variable is here for synchronization reasons for speeding up or down animation; variable can be static if u want;
+// returns changed "io_rect"; in specific: to "y" & "x" are added some number,"h" and "w" are totaly changed;
+// also returns pointer to "out_image_pointer" of texture that should be displayed in animation:
+    void execute_animation(SDL_Texture** out_image_pointer,SDL_Rect* io_rect,uint32_t actual_fps);
+//      it's the same function as "execute_animation" except it's additionally draws animation into render;
+    void execute_animation_draw(SDL_Rect* io_rect,uint32_t actual_fps,SDL_Renderer* render);
+
+//      changes "original_images_h" & "original_images_w";
+// if u don't want to change some variable,just place there -1;
+    void change_images_original_w_h(int32_t original_images_h,int32_t original_images_w);
+
+//      adds number to actual scalling variable;
+    void change_scaling_dynamically(float scaling);
+//      swaps actual scaling variable inside class with this one;
+// "scaling" should be above 0.0;
+    void change_scaling(float scaling);
+    void change_scaling_type(ScalingType scaling_type);
+
+// number should be above 0.0;
+    void change_speed(float speed);
+    void change_speed_dynamically(float speed);
+// if "left_or_right" == 0 then direction will be left; else if 1 then will be right;
+    void change_direction(bool left_or_right);
+
+    void change_image_front(SDL_Texture* front_image);
+    void change_image_back(SDL_Texture* back_image);
 
 // returns stage of half flips;
 //      returns 0 if animation is at first stage;
@@ -1984,10 +2805,32 @@ void cSDL_Anim3D_Yaxis_border::_cSDL_anim3D_vertical_flip_border(int32_t& io_mai
 // #include <SDL2/SDL.h>
 // #include <stdint.h>
 // #include <stdlib.h>
+//      mouse hit-test of buttons uses SSE2/AVX2 instructions if compilator generates them (for example "-msse2"/"-mavx2" in GNU/clang,
+//          x64 or "/arch:AVX2" in MSVC); define "CSDL_BUTTONS_NO_SIMD" before including this file to use only scalar code;
+#ifndef CSDL_BUTTONS_NO_SIMD
+    #if defined(__AVX2__)
+        #define CSDL_BUTTONS_HIT_TEST_AVX2
+        #include <immintrin.h>
+    #elif defined(__SSE2__)||defined(_M_X64)||(defined(_M_IX86_FP)&&_M_IX86_FP>=2)
+        #define CSDL_BUTTONS_HIT_TEST_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
+//      size in bytes of storage inside of every event for callable (like lambda with captures) passed to templated "create_event()";
+//          define it before including this file if u need to capture more;
+#ifndef CSDL_EVENT_CALLABLE_SIZE
+    #define CSDL_EVENT_CALLABLE_SIZE 32
+#endif
+//      buttons that cover more cells of spatial index than this aren't copied to cells but are kept in one list checked by every mouse motion;
+//          it keeps size of the grid at most "count_of_buttons*CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON" even if buttons are large or overlapping;
+#ifndef CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON
+    #define CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON 16
+#endif
 class cSDL_ButtonsManager
 {
 public:
     enum FocusType {KEYBOARD,MOUSE};
+    enum HitTestPath {HIT_TEST_SCALAR,HIT_TEST_SSE2,HIT_TEST_AVX2};
     enum TypeOfFocusInteraction {NEAREST_LEFT,NEAREST_RIGHT,NEAREST_UP,NEAREST_DOWN,FAR_LEFT,FAR_RIGHT,FAR_DOWN,FAR_UP};
     enum TypeOfPress {DOWN_UP,DOWN,UP,HOLD_DOWN_COMBINATION};
     enum MouseEventValue {MOUSE_BUTTON_RIGHT = SDL_BUTTON_RIGHT,MOUSE_BUTTON_LEFT = SDL_BUTTON_LEFT,
@@ -2017,6 +2860,25 @@ public:
 //          u should after enabling this,run "force_mouse_position_event_update()" every frame; by default it's 0 (OFF);
     void enable_check_mouse_motion_only_in_force_mouse_position_event_update(bool enable);
 
+//      enable uniform grid of buttons used to find which button is pointed by mouse cursor; without it every mouse motion checks every button,
+//          with it only buttons from one cell of the grid are checked; it's usefull when u have hundreds/thousands of buttons; by default it's 0 (OFF);
+//          grid is rebuilt automatically (only when needed) after creating/deleting/changing buttons or after changing scaling;
+//          buttons covering more than "CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON" cells are checked by every mouse motion like without the grid;
+//  "enable": 1 to enable,0 to disable;
+//  "cell_size": width and height of one cell of the grid in pixels; if it's 0 then it will be changed to 64; if there would be too many cells
+//      for actual count of buttons then cell size is increased automatically;
+    void enable_spatial_index(bool enable,uint32_t cell_size);
+
+//      forces rebuilding of internal caches of buttons (like spatial index or map of ids); caches are rebuilt lazily at their next use;
+//          every call of "get_button_vector()" already does it so it's needed only if u keep reference to the vector and change it again after using other functions;
+    void force_buttons_cache_update();
+//      forces rebuilding of internal caches of events (like map of ids or dispatch index); caches are rebuilt lazily at their next use;
+//          every call of "get_event_vector()" already does it so it's needed only if u keep reference to the vector and change it again after using other functions;
+    void force_events_cache_update();
+
+//      returns which implementation of mouse hit-test was compiled in (scalar,SSE2 - 4 buttons at once,AVX2 - 8 buttons at once);
+    static HitTestPath get_hit_test_path();
+
 //      forcefully change which device should have focus;
 //  "new_focus_device": device type;
     void set_manually_focus_device(cSDL_ButtonsManager::FocusType new_focus_device);
@@ -2068,12 +2930,20 @@ public:
 //  "user_data": should be pointer to ur data that u want to pass to the function callback when event activates; can be NULL if u don't need it;
 //  returns "id" of the created object;
     uint32_t create_event(void (*activated_func)(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj),void* user_data);
+//      the same as above but callback is any callable object (like lambda with captures) called as "function(event,class_obj)";
+//          callable is kept inside of event (no heap allocation,no std::function) so it must be trivially copyable (capture only pointers,references
+//          and simple values) and not larger than "CSDL_EVENT_CALLABLE_SIZE" bytes; it's checked at compilation;
+//          callable is called on its copy so changes of captured variables made by "mutable" lambda aren't kept between calls;
+//  returns "id" of the created object;
+    template <typename F> uint32_t create_event(F function);
 
 //      function to change callback of existing event;
 //  "event_id": id of the event u want to change; if event with this id doesn't exist then function doesn't do anything;
 //  "activated_func": should be new pointer to the new function u want to link with the event;
 //  "user_data": new user pointer data that u want to be passed to the function callback when event is activated;
     void change_event_callback_function(uint32_t event_id,void (*activated_func)(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj),void* user_data);
+//  "function": new callable object with the same rules as in templated "create_event()";
+    template <typename F> void change_event_callback_function(uint32_t event_id,F function);
 
 //      there are important functions that should be executed after creating event; these functions manipulate which keys should be pressed to activate event;
     void add_required_key_for_event(uint32_t event_id,cSDL_ButtonsManager::TypeOfPress type,SDL_Keycode key);
@@ -2113,7 +2983,9 @@ public:
 //      available index then function fails;
 //  "to_index": decides at what index of vector should deleting operation stop; if "to_index" is lower than "from_index"
 //      then function fails; if "to_index" is larger than maximum index then "to_index" is changed automatically to maximum index;
-//  "id": id of element to delete;
+//  "id": id of element to delete; deleting by id costs O(1): element is only marked as deleted and all marked elements are removed
+//      from vector at once (order of the rest doesn't change) by the next function that needs indexes like "run_event_checker()";
+//      so deleting many elements one by one by id doesn't move the whole vector every time;
     void delete_buttons(uint32_t from_index,uint32_t to_index);
     void delete_events(uint32_t from_index,uint32_t to_index);
     void delete_buttons(uint32_t id);
@@ -2141,6 +3013,10 @@ public:
 
 //      this function is the most heavy; should be called everytime u call "SDL_PollEvent()";
     void run_event_checker(SDL_Event* event);
+//      same as calling "run_event_checker()" for every event from "events" in order (callbacks get the copy of event);
+//          consecutive "SDL_MOUSEMOTION" events that can't complete any event are coalesced so only the needed hit-tests of the mouse are done;
+//          u can collect all events from "SDL_PollEvent()" of one frame and pass them here;
+    void run_event_checker_batch(const SDL_Event* events,size_t count);
 
 //---------------------------------------------------------------------------------------------
 
@@ -2170,13 +3046,13 @@ public:
     };
     struct GainKeyFocus
     {
-        CustomVector<SDL_Keycode> gain_focus_options; // if u hit any of this buttons,device gain focus;
+        SmallCustomVector<SDL_Keycode,4> gain_focus_options; // if u hit any of this buttons,device gain focus;
         bool gain_focus_by_any_key_press; //  by default this variable is 1 (ON); if it's 1 then "gain_focus_options" is ignored;
         TypeOfPressToGainFocus type_of_press;   // default is "PRESS_DOWN_OR_UP";
     };
     struct GainMouseFocus
     {
-        CustomVector<MouseEventValue> gain_focus_options;   // if u hit any of this buttons,device gain focus;
+        SmallCustomVector<MouseEventValue,4> gain_focus_options;   // if u hit any of this buttons,device gain focus;
         bool gain_focus_by_any_mouse_press; //  by default this variable is 1 (ON); if it's 1 then "gain_focus_options" is ignored;
         TypeOfPressToGainFocus type_of_press;   // default is "PRESS_DOWN_OR_UP";
     };
@@ -2197,9 +3073,13 @@ public:
         void* user_data; // pointer to data that user passes when he creates this event structure;
         uint32_t id;    // special unical id for this event; no other event can have this id; shouldn't be changed manually;
 
-        CustomVector<KeyEvent> k_events;
-        CustomVector<MouseEvent> m_events;
-        CustomVector<SpecialEvent> s_events;
+        void (*callable_invoker)(void* callable,SDL_Event* event,cSDL_ButtonsManager* class_obj);   // NULL if event uses "activated_func"; otherwise it calls
+                                                                                                    //      object from "callable_storage";
+        alignas(16) unsigned char callable_storage[CSDL_EVENT_CALLABLE_SIZE];   // callable object passed to templated "create_event()";
+
+        SmallCustomVector<KeyEvent,2> k_events;         // requirements are kept inside of event (without heap memory) until there's more of them
+        SmallCustomVector<MouseEvent,2> m_events;       //      than size of inline storage;
+        SmallCustomVector<SpecialEvent,2> s_events;
 
         SDL_Rect focus_interaction_area;  // make w == -1 it u don't want to use "auto changing focus" mechanism; by default it's -1 (OFF); this variable decides about
                                             //      size of the area that buttons can be seen; if some button is not as a whole in this area then "auto changing focus" will not be performed on that button;
@@ -2220,16 +3100,25 @@ public:
 
 private:
     CustomVector<Event> _events;
+    mutable CustomIdMap _events_id_map;     // "id" of event -> index in "_events"; it's kept in sync with "_events" by every function that adds/erases events;
+    mutable bool _events_id_map_needs_rebuild;  // set after "_events" was given outside by "get_event_vector()"; map is rebuilt at next search of id;
     uint32_t _oryginal_event_id;   // this variable only increasing its value; it's for creating "id" for "Event";
+    size_t _count_of_deleted_events;    // events deleted by id have "id" 0 until "_remove_deleted_events()" erases them from "_events";
+    CustomVector<uint32_t> _deleted_events_tree;    // Fenwick tree of deleted events (used only if "_count_of_deleted_events" isn't 0);
 
     FocusType _actual_device_focus;     // by default it's "KEYBOARD";
     GainKeyFocus _key_focus_options;
     GainMouseFocus _mouse_focus_options;
 
     CustomVector<Button> _buttons;
+    mutable CustomIdMap _buttons_id_map;    // "id" of button -> index in "_buttons"; it's kept in sync with "_buttons" by every function that adds/erases buttons;
+    mutable bool _buttons_id_map_needs_rebuild; // set after "_buttons" was given outside by "get_button_vector()"; map is rebuilt at next search of id;
     uint32_t _oryginal_button_id;   // this variable only increasing its value; it's for creating "id" for "Button";
+    size_t _count_of_deleted_buttons;   // buttons deleted by id have "id" 0 until "_remove_deleted_buttons()" erases them from "_buttons";
+    CustomVector<uint32_t> _deleted_buttons_tree;   // Fenwick tree of deleted buttons (used only if "_count_of_deleted_buttons" isn't 0);
     size_t _actual_button_index_focus;   // if it's 0xFFFFFFFF then there's no focus on any button; by default it's 0xFFFFFFFF; it's for optymalization reasons;
     uint32_t _actual_button_id_focus;     // if it's 0 then there's no focus on any button; by default it's 0;
+    bool _actual_button_index_focus_needs_update;   // set after "_buttons" was given outside; index is found again by id in "_remove_deleted_buttons()";
 
     bool _check_mouse_motion_only_in_force_mouse_position_event_update; // to enable/disable checking mouse motion from function "run_event_checker()"; by default it's 0 (OFF);
     double _scale_button_dimensions_x; double _scale_button_dimensions_y;
@@ -2237,6 +3126,115 @@ private:
                                                 // button_dimensions*_scale_button_dimensions; by default it's '0' (OFF);
                                                 // it's mainly for correct mouse position checker;
 
+    bool _use_spatial_index;    // by default it's 0 (OFF);
+    bool _spatial_index_needs_rebuild;  // set by every function that changes buttons or scaling; grid is rebuilt lazily before next mouse checking;
+    int32_t _spatial_index_cell_size;   // cell size requested by user;
+    int64_t _spatial_index_actual_cell_size;    // cell size used by actual grid; can be larger than "_spatial_index_cell_size";
+    int32_t _spatial_index_x; int32_t _spatial_index_y;     // top left corner of the grid (after scaling);
+    int32_t _spatial_index_columns; int32_t _spatial_index_rows;
+    CustomVector<uint32_t> _spatial_index_cell_start;   // "columns*rows+1" elements; buttons of cell 'c' are in "_spatial_index_buttons" from [c] to [c+1];
+    CustomVector<uint32_t> _spatial_index_buttons;  // indexes of buttons for every cell; in every cell indexes are sorted from the lowest;
+    CustomVector<uint32_t> _spatial_index_large_buttons;    // sorted indexes of buttons that cover more than "CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON" cells;
+    CustomVector<int32_t> _spatial_index_large_x; CustomVector<int32_t> _spatial_index_large_y;     // hitboxes of large buttons in the same order
+    CustomVector<int32_t> _spatial_index_large_w; CustomVector<int32_t> _spatial_index_large_h;     //      so they're checked by SIMD hit-test;
+    CustomVector<int32_t> _spatial_index_large_mask;    // always -1;
+
+//      returns dimensions of button in the same form as they are checked with mouse position (after scaling);
+    SDL_Rect _get_button_hitbox(size_t index) const;
+//      returns index of the most upper button (the last one in vector) that is pointed by "x","y" and can gain focus by cursor; returns -1 if there's no button;
+    int64_t _find_button_at_position(int32_t x,int32_t y);
+//      uses hitboxes from "_button_x/_y/_w/_h" so they have to be up to date before;
+    void _rebuild_spatial_index();
+
+//      copy of buttons hitboxes (already scaled if scaling mechanism is ON) in structure of arrays (every field in separate array) used by mouse hit-test
+//          so it reads only what it needs and doesn't multiply anything by scale; "_buttons" is still the main storage (so "get_button_vector()" works like before);
+//          entries are updated with every change of button; all arrays are rebuilt lazily only after change of scaling or "force_buttons_cache_update()";
+    bool _button_arrays_need_rebuild;
+    CustomVector<int32_t> _button_x; CustomVector<int32_t> _button_y;
+    CustomVector<int32_t> _button_w; CustomVector<int32_t> _button_h;
+    CustomVector<int32_t> _button_gain_focus_mask;  // -1 (all bits set) if button can gain focus by mouse cursor,0 otherwise;
+
+    void _rebuild_button_arrays();
+//      writes hitbox of button 'i' to arrays; if 'i' is equal to size of arrays then it's added at the end;
+    void _write_button_arrays_entry(size_t i);
+//      returns the highest index 'i' for which point is inside rect "x[i],y[i],x[i]+w[i],y[i]+h[i]" (edges included) and mask[i] isn't 0; returns -1 if there's no such rect;
+    static int64_t _find_last_rect_containing_point(const int32_t* x,const int32_t* y,const int32_t* w,const int32_t* h,const int32_t* mask,size_t count,int32_t point_x,int32_t point_y);
+
+//      navigation index for "auto focus changing" mechanism (NEAREST_*/FAR_*); it uses not scaled "button_dimensions" like mechanism always did;
+//          for every direction it finds the best position on the main axis among buttons in perpendicular range in O(log^2(n)) with merge sort tree
+//          and then the best button with that position in O(log(n)); rebuilt lazily after any change of buttons;
+    bool _navigation_index_needs_rebuild;
+    size_t _navigation_count_of_buttons_without_width;  // if there's button with w==-1 then linear search is used 'cause it treats such button specially;
+    CustomVector<uint32_t> _navigation_sorted_by_x;     // indexes of buttons sorted by x,then by y,then by index;
+    CustomVector<uint32_t> _navigation_sorted_by_y;     // indexes of buttons sorted by y,then by x,then by index;
+    CustomVector<int32_t> _navigation_x_levels;     // "_navigation_levels_count" levels of 'n' elements; level 'l' has x of buttons in order of "_navigation_sorted_by_y"
+                                                    //      where every block of 2^l elements is sorted;
+    CustomVector<int32_t> _navigation_y_levels;     // the same for y of buttons in order of "_navigation_sorted_by_x";
+    size_t _navigation_levels_count;
+
+    void _rebuild_navigation_index();
+//      sorts indexes of buttons by x (or by y if "by_y" is 1),then by the second axis,then by index;
+    void _sort_navigation_indexes(CustomVector<uint32_t>& indexes,bool by_y);
+//      returns index of button chosen by "auto focus changing" mechanism from actual focused button or -1 if there's no such button;
+    int64_t _find_button_in_direction(TypeOfFocusInteraction interaction,uint32_t max_perpendicular_difference);
+    int64_t _find_button_in_direction_linear(bool vertical,bool negative,bool nearest,uint32_t max_perpendicular_difference) const;
+
+//      return index of button/event with passed id or 0xFFFFFFFF if there's no such id; O(1) thanks to "_buttons_id_map"/"_events_id_map";
+    size_t _find_button_index(uint32_t id) const;
+    size_t _find_event_index(uint32_t id) const;
+//      write to the map indexes of every button/event from "first_index" to the end of vector; used after erasing elements that shifts the rest of vector;
+    void _update_buttons_id_map(size_t first_index);
+    void _update_events_id_map(size_t first_index);
+//      rebuild whole map from the vector; used lazily after vector could be changed by user;
+    void _rebuild_buttons_id_map() const;
+    void _rebuild_events_id_map() const;
+//      mark every cache made from "_buttons"/"_events" as outdated; they're rebuilt lazily when they're needed;
+    void _invalidate_buttons_caches();
+    void _invalidate_events_caches();
+//      erase from vector every button/event marked as deleted (with "id" 0) in one pass; order of the rest is kept;
+//          it's run at the beginning of every function that uses/returns indexes so outside of these functions indexes are the same as without marking;
+//          "_remove_deleted_buttons()" updates also index of focused button if buttons were given outside;
+    void _remove_deleted_buttons();
+    void _remove_deleted_events();
+//      returns index that element will have after removing deleted elements; used by const functions that can't remove them;
+//          O(log(n)) thanks to Fenwick tree of deleted elements ("_deleted_buttons_tree"/"_deleted_events_tree");
+    size_t _get_index_without_deleted_buttons(size_t index) const;
+    size_t _get_index_without_deleted_events(size_t index) const;
+//      Fenwick tree with count of deleted elements for every prefix of vector; tree is filled with zeros for "size" elements when the first element is marked
+//          as deleted (after every removing of deleted elements) so it's O(n) once per removing which costs O(n) anyway;
+    static void _deleted_tree_mark(CustomVector<uint32_t>& tree,size_t count_of_deleted,size_t size,size_t index);
+//      adds element at the end of vector (not deleted) to the tree;
+    static void _deleted_tree_push_back(CustomVector<uint32_t>& tree);
+//      returns how many elements from [0,count) are deleted;
+    static size_t _deleted_tree_prefix(const CustomVector<uint32_t>& tree,size_t count);
+
+//      dispatch index of events; for every key/mouse button/type of SDL event there's a list of indexes of events that have requirement
+//          for it so "run_event_checker()" checks only events that can react on actual SDL event instead of all of them;
+//          index is rebuilt lazily by "run_event_checker()" after any change of events or their requirements;
+    bool _event_dispatch_index_needs_rebuild;
+    CustomIdMap _event_dispatch_keys_map;       // SDL_Keycode -> number of list;
+    CustomIdMap _event_dispatch_mouse_map;      // MouseEventValue -> number of list;
+    CustomIdMap _event_dispatch_special_map;    // SDL_EventType -> number of list;
+    CustomVector<uint32_t> _event_dispatch_lists_start;    // indexes of events of list 'l' are in "_event_dispatch_events" from [l] to [l+1];
+    CustomVector<uint32_t> _event_dispatch_events;          // indexes of events for every list; in every list indexes are sorted from the lowest;
+    CustomVector<bool> _event_ready_without_input;  // for every event: 1 if event is completed even by SDL event that isn't related to any of its requirements;
+                                                    //      (event without requirements or with only held "HOLD_DOWN_COMBINATION" keys/mouse buttons);
+    size_t _count_of_events_ready_without_input;    // if it's not 0 then every event has to be checked;
+
+    void _rebuild_event_dispatch_index();
+    void _get_event_dispatch_list(const CustomIdMap& map,uint32_t key,uint32_t& first,uint32_t& last) const;
+//      updates "_event_ready_without_input" of event after changes of its requirements state;
+    void _update_event_dispatch_state(size_t i);
+//      checks requirements of event and updates their state; returns 1 if every requirement is met;
+    bool _check_event_requirements(size_t i,SDL_Event* event);
+//      performs "auto focus changing" mechanism of event and runs its callback;
+    void _activate_event(size_t i,SDL_Event* event);
+//      puts callable into storage of event;
+    template <typename F> static void _set_event_callable(Event& event,const F& function);
+    template <typename F> static void _invoke_event_callable(void* callable,SDL_Event* event,cSDL_ButtonsManager* class_obj);
+//      returns 1 if any event can be completed by SDL event of passed type;
+    bool _event_dispatch_reacts_to_type(uint32_t type);
+
 public:
 // manual dangerous functions; use this functions only if u're know what u doing; remember that "CustomVector" variables
 //      can change their inside variables address so be carefull; if u want to use these functions safely,u shouldn't change their variables,
@@ -2260,12 +3258,32 @@ cSDL_ButtonsManager::cSDL_ButtonsManager()
     this->_mouse_focus_options.type_of_press = TypeOfPressToGainFocus::PRESS_DOWN_OR_UP;
 
     this->_oryginal_button_id = 1;
+    this->_count_of_deleted_buttons = 0;
+    this->_count_of_deleted_events = 0;
     this->_actual_button_index_focus = 0xFFFFFFFF;
     this->_actual_button_id_focus = 0;
+    this->_actual_button_index_focus_needs_update = 0;
+    this->_buttons_id_map_needs_rebuild = 0;
+    this->_events_id_map_needs_rebuild = 0;
 
     this->_check_mouse_motion_only_in_force_mouse_position_event_update = 0;
     this->_do_buttons_scals_with_window_w_h = 0;
 
+    this->_use_spatial_index = 0;
+    this->_spatial_index_needs_rebuild = 1;
+    this->_spatial_index_cell_size = 64;
+    this->_spatial_index_actual_cell_size = 64;
+    this->_spatial_index_x = 0; this->_spatial_index_y = 0;
+    this->_spatial_index_columns = 0; this->_spatial_index_rows = 0;
+
+    this->_navigation_index_needs_rebuild = 1;
+    this->_navigation_count_of_buttons_without_width = 0;
+    this->_button_arrays_need_rebuild = 1;
+    this->_navigation_levels_count = 0;
+
+    this->_event_dispatch_index_needs_rebuild = 1;
+    this->_count_of_events_ready_without_input = 0;
+
     return;
 }
 
@@ -2274,6 +3292,8 @@ void cSDL_ButtonsManager::enable_scaling_mechanism(bool enable)
     this->_do_buttons_scals_with_window_w_h = enable;
     this->_scale_button_dimensions_x = 1.0;
     this->_scale_button_dimensions_y = 1.0;
+    this->_spatial_index_needs_rebuild = 1;
+    this->_button_arrays_need_rebuild = 1;
     return;
 }
 
@@ -2281,11 +3301,15 @@ void cSDL_ButtonsManager::update_scaling_mechanism(uint32_t oryginal_window_w,ui
 {
     this->_scale_button_dimensions_x = (double)((double)new_window_w/(double)oryginal_window_w);
     this->_scale_button_dimensions_y = (double)((double)new_window_h/(double)oryginal_window_h);
+    this->_spatial_index_needs_rebuild = 1;
+    this->_button_arrays_need_rebuild = 1;
     return;
 }
 
 void cSDL_ButtonsManager::force_mouse_position_event_update()
 {
+    this->_remove_deleted_buttons();
+
     if(this->_actual_button_index_focus!=0xFFFFFFFF&&this->_actual_device_focus==FocusType::MOUSE)
     {
         this->_actual_button_id_focus = 0;
@@ -2295,32 +3319,14 @@ void cSDL_ButtonsManager::force_mouse_position_event_update()
     int32_t mouse_x,mouse_y;
     SDL_GetMouseState(&mouse_x,&mouse_y);
 
-    int64_t count_of_buttons = this->_buttons.size();
-    count_of_buttons--;
-    for(int64_t i = count_of_buttons; i>=0; i--)
+    int64_t i = this->_find_button_at_position(mouse_x,mouse_y);
+    if(i!=-1)
     {
-        if(this->_buttons[i].gain_focus_by_mouse_cursor==1)
-        {
-            SDL_Rect dimensions = this->_buttons[i].button_dimensions;
-            if(this->_do_buttons_scals_with_window_w_h==1)
-            {
-                dimensions.x*=this->_scale_button_dimensions_x;
-                dimensions.w*=this->_scale_button_dimensions_x;
-                dimensions.y*=this->_scale_button_dimensions_y;
-                dimensions.h*=this->_scale_button_dimensions_y;
-            }
-            if((mouse_x>=dimensions.x&&mouse_x<=(dimensions.x+dimensions.w))&&(mouse_y>=dimensions.y&&mouse_y<=(dimensions.y+dimensions.h)))
-            {
-                    this->_actual_button_id_focus = this->_buttons[i].id;
-                    this->_actual_button_index_focus = i;
-                    this->_actual_device_focus = FocusType::MOUSE;
-                    break;
-            }
-        }
+        this->_actual_button_id_focus = this->_buttons[i].id;
+        this->_actual_button_index_focus = i;
+        this->_actual_device_focus = FocusType::MOUSE;
     }
 
-
-
     return;
 }
 
@@ -2330,6 +3336,37 @@ void cSDL_ButtonsManager::enable_check_mouse_motion_only_in_force_mouse_position
     return;
 }
 
+void cSDL_ButtonsManager::enable_spatial_index(bool enable,uint32_t cell_size)
+{
+    if(cell_size==0) cell_size = 64;
+    else if(cell_size>0x40000000) cell_size = 0x40000000;
+    this->_use_spatial_index = enable;
+    this->_spatial_index_cell_size = cell_size;
+    this->_spatial_index_needs_rebuild = 1;
+    if(enable==0)   // free memory of the grid;
+    {
+        this->_spatial_index_cell_start.clear();
+        this->_spatial_index_buttons.clear();
+        this->_spatial_index_large_buttons.clear();
+        this->_spatial_index_large_x.clear(); this->_spatial_index_large_y.clear();
+        this->_spatial_index_large_w.clear(); this->_spatial_index_large_h.clear();
+        this->_spatial_index_large_mask.clear();
+    }
+    return;
+}
+
+void cSDL_ButtonsManager::force_buttons_cache_update()
+{
+    this->_invalidate_buttons_caches();
+    return;
+}
+
+void cSDL_ButtonsManager::force_events_cache_update()
+{
+    this->_invalidate_events_caches();
+    return;
+}
+
 void cSDL_ButtonsManager::set_manually_focus_device(cSDL_ButtonsManager::FocusType new_focus_device)
 {
     this->_actual_device_focus = new_focus_device;
@@ -2338,15 +3375,11 @@ void cSDL_ButtonsManager::set_manually_focus_device(cSDL_ButtonsManager::FocusTy
 
 void cSDL_ButtonsManager::set_manually_button_focus(uint32_t button_id)
 {
-    size_t size = this->_buttons.size();
-    for(size_t i = 0; i<size; i++)
+    const size_t i = this->_find_button_index(button_id);
+    if(i!=0xFFFFFFFF)
     {
-        if(button_id==this->_buttons[i].id)
-        {
-            this->_actual_button_id_focus = button_id;
-            this->_actual_button_index_focus = i;
-            break;
-        }
+        this->_actual_button_id_focus = button_id;
+        this->_actual_button_index_focus = i;
     }
     return;
 }
@@ -2417,23 +3450,15 @@ uint32_t cSDL_ButtonsManager::create_button(SDL_Rect button_dimensions,bool gain
     button.id = button_id;
     button.user_custom_data = user_custom_data;
     this->_buttons.push_back(button);
+    if(this->_count_of_deleted_buttons!=0) _deleted_tree_push_back(this->_deleted_buttons_tree);
+    this->_buttons_id_map.insert(button_id,this->_buttons.size()-1);
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+    if(this->_button_arrays_need_rebuild==0) this->_write_button_arrays_entry(this->_buttons.size()-1);
 
-    size_t size = this->_buttons.size();
-    bool should_be_actual_focus_disabled = 1;
-    for(size_t i = 0; i<size; i++)
-    {
-        if(this->_buttons[i].id==this->_actual_button_id_focus)
-        {
-            this->_actual_button_index_focus = i;
-            should_be_actual_focus_disabled = 0;
-            break;
-        }
-    }
-    if(should_be_actual_focus_disabled==1)
-    {
-        this->_actual_button_id_focus = 0;
-        this->_actual_button_index_focus = 0xFFFFFFFF;
-    }
+    // new button is added at the end so index of focused button doesn't change;
+    this->_actual_button_index_focus = this->_find_button_index(this->_actual_button_id_focus);
+    if(this->_actual_button_index_focus==0xFFFFFFFF) this->_actual_button_id_focus = 0;
 
     return button_id;
 }
@@ -2445,51 +3470,77 @@ uint32_t cSDL_ButtonsManager::create_event(void (*activated_func)(void* user_dat
 
     Event event;
     event.activated_func = activated_func;
+    event.callable_invoker = NULL;
+    event.focus_interaction_area.x = 0; event.focus_interaction_area.y = 0; event.focus_interaction_area.h = 0;
     event.focus_interaction_area.w = -1;        // -1 to OFF "auto focus changing" mechanism;
+    event.main_focus_interaction = TypeOfFocusInteraction::NEAREST_LEFT;
+    event.addtional_focus_interaction = TypeOfFocusInteraction::NEAREST_LEFT;
+    event.max_perpendicular_difference = 0;
+    event.max_perpendicular_difference_additional = 0;
     event.default_button_focus_id = 0;
     event.id = event_id;
     event.user_data = user_data;
 
-    this->_events.push_back(event);
+    this->_events.push_back(std::move(event));
+    if(this->_count_of_deleted_events!=0) _deleted_tree_push_back(this->_deleted_events_tree);
+    this->_event_dispatch_index_needs_rebuild = 1;
+    this->_events_id_map.insert(event_id,this->_events.size()-1);
 
     return event_id;
 }
 
 void cSDL_ButtonsManager::change_event_callback_function(uint32_t event_id,void (*activated_func)(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj),void* user_data)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].activated_func = activated_func;
     this->_events[i].user_data = user_data;
+    this->_events[i].callable_invoker = NULL;
+
+    return;
+}
+
+template <typename F> uint32_t cSDL_ButtonsManager::create_event(F function)
+{
+    const uint32_t event_id = this->create_event(NULL,NULL);
+    _set_event_callable(this->_events[this->_events.size()-1],function);
+    return event_id;
+}
+
+template <typename F> void cSDL_ButtonsManager::change_event_callback_function(uint32_t event_id,F function)
+{
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
+
+    this->_events[i].activated_func = NULL;
+    this->_events[i].user_data = NULL;
+    _set_event_callable(this->_events[i],function);
+
+    return;
+}
+
+template <typename F> void cSDL_ButtonsManager::_set_event_callable(Event& event,const F& function)
+{
+    static_assert(sizeof(F)<=CSDL_EVENT_CALLABLE_SIZE,"callable is too large for event; capture less or define larger CSDL_EVENT_CALLABLE_SIZE");
+    static_assert(alignof(F)<=16,"callable needs larger alignment than storage of event");
+    static_assert(std::is_trivially_copyable<F>::value,"callable must be trivially copyable; capture only pointers,references and simple values");
+
+    memcpy(event.callable_storage,(const void*)&function,sizeof(F));
+    event.callable_invoker = &_invoke_event_callable<F>;
+    return;
+}
 
+template <typename F> void cSDL_ButtonsManager::_invoke_event_callable(void* callable,SDL_Event* event,cSDL_ButtonsManager* class_obj)
+{
+    (*reinterpret_cast<F*>(callable))(event,class_obj);
     return;
 }
 
 void cSDL_ButtonsManager::add_required_key_for_event(uint32_t event_id,cSDL_ButtonsManager::TypeOfPress type,SDL_Keycode key)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     KeyEvent key_event;
     key_event.key = key;
@@ -2498,23 +3549,14 @@ void cSDL_ButtonsManager::add_required_key_for_event(uint32_t event_id,cSDL_Butt
     key_event.type = type;
 
     this->_events[i].k_events.push_back(key_event);
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::add_required_mouse_key_for_event(uint32_t event_id,cSDL_ButtonsManager::TypeOfPress type,cSDL_ButtonsManager::MouseEventValue mouse_key)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     MouseEvent mouse_event;
     mouse_event.mouse_key = mouse_key;
@@ -2523,106 +3565,62 @@ void cSDL_ButtonsManager::add_required_mouse_key_for_event(uint32_t event_id,cSD
     mouse_event.type = type;
 
     this->_events[i].m_events.push_back(mouse_event);
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::add_required_special_type_for_event(uint32_t event_id,SDL_EventType type)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     SpecialEvent special_event;
     special_event.type = type;
 
     this->_events[i].s_events.push_back(special_event);
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::delete_all_required_keys_for_event(uint32_t event_id)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].k_events.clear();
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::delete_all_required_mouse_keys_for_event(uint32_t event_id)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].m_events.clear();
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::delete_all_required_special_types_for_event(uint32_t event_id)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].s_events.clear();
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
 void cSDL_ButtonsManager::delete_all_requires_for_event(uint32_t event_id)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].k_events.clear();
     this->_events[i].m_events.clear();
     this->_events[i].s_events.clear();
+    this->_event_dispatch_index_needs_rebuild = 1;
 
     return;
 }
@@ -2631,18 +3629,8 @@ void cSDL_ButtonsManager::change_event_auto_focus_mechanism(uint32_t event_id,SD
                                        cSDL_ButtonsManager::TypeOfFocusInteraction additional_focus_interaction,uint32_t max_perpendicular_difference,
                                        uint32_t max_perpendicular_difference_additional,uint32_t default_button_focus_id)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==event_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_event_index(event_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_events[i].focus_interaction_area = focus_interaction_area;
     this->_events[i].main_focus_interaction = main_focus_interaction;
@@ -2656,56 +3644,31 @@ void cSDL_ButtonsManager::change_event_auto_focus_mechanism(uint32_t event_id,SD
 
 void cSDL_ButtonsManager::change_button_dimensions(uint32_t button_id,SDL_Rect button_dimensions)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_buttons.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_buttons[i].id==button_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_button_index(button_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_buttons[i].button_dimensions = button_dimensions;
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+    if(this->_button_arrays_need_rebuild==0) this->_write_button_arrays_entry(i);
 
     return;
 }
 void cSDL_ButtonsManager::change_button_attribute_to_gain_focus_by_cursor(uint32_t button_id,bool gain_focus_by_mouse_cursor)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_buttons.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_buttons[i].id==button_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_button_index(button_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_buttons[i].gain_focus_by_mouse_cursor = gain_focus_by_mouse_cursor;
+    this->_spatial_index_needs_rebuild = 1;
+    if(this->_button_arrays_need_rebuild==0) this->_write_button_arrays_entry(i);
 
     return;
 }
 void cSDL_ButtonsManager::change_button_user_custom_data(uint32_t button_id,uint32_t user_custom_data)
 {
-    bool does_id_exists = 0;
-    size_t size = this->_buttons.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_buttons[i].id==button_id)
-        {
-            does_id_exists = 1;
-            break;
-        }
-    }
-    if(does_id_exists==0) return;
+    const size_t i = this->_find_button_index(button_id);
+    if(i==0xFFFFFFFF) return;
 
     this->_buttons[i].user_custom_data = user_custom_data;
 
@@ -2714,105 +3677,100 @@ void cSDL_ButtonsManager::change_button_user_custom_data(uint32_t button_id,uint
 
 size_t cSDL_ButtonsManager::get_count_of_buttons() const
 {
-    return this->_buttons.size();
+    return this->_buttons.size()-this->_count_of_deleted_buttons;
 }
 size_t cSDL_ButtonsManager::get_count_of_events() const
 {
-    return this->_events.size();
+    return this->_events.size()-this->_count_of_deleted_events;
 }
 
 void cSDL_ButtonsManager::delete_buttons(uint32_t from_index,uint32_t to_index)
 {
+    this->_remove_deleted_buttons();
+    const size_t size = this->_buttons.size();
+    if(from_index>=size||from_index>to_index) return;
+    if(to_index>=size) to_index = size-1;
+
+    for(size_t i = from_index; i<=to_index; i++) this->_buttons_id_map.erase(this->_buttons[i].id);
     this->_buttons.erase(from_index,to_index);
+    this->_update_buttons_id_map(from_index);
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+    if(this->_button_arrays_need_rebuild==0)
+    {
+        this->_button_x.erase(from_index,to_index); this->_button_y.erase(from_index,to_index);
+        this->_button_w.erase(from_index,to_index); this->_button_h.erase(from_index,to_index);
+        this->_button_gain_focus_mask.erase(from_index,to_index);
+    }
 
     if(this->_actual_button_index_focus!=0xFFFFFFFF)
     {
-        bool does_id_exists = 0;
-        size_t size = this->_buttons.size();
-        size_t i = 0;
-        for(; i<size; i++)
-        {
-            if(this->_buttons[i].id==this->_actual_button_id_focus)
-            {
-                does_id_exists = 1;
-                this->_actual_button_index_focus = i;
-                break;
-            }
-        }
-        if(does_id_exists==0)
-        {
-            this->_actual_button_id_focus = 0;
-            this->_actual_button_index_focus = 0xFFFFFFFF;
-        }
+        this->_actual_button_index_focus = this->_find_button_index(this->_actual_button_id_focus);
+        if(this->_actual_button_index_focus==0xFFFFFFFF) this->_actual_button_id_focus = 0;
     }
 
     return;
 }
 void cSDL_ButtonsManager::delete_events(uint32_t from_index,uint32_t to_index)
 {
+    this->_remove_deleted_events();
+    const size_t size = this->_events.size();
+    if(from_index>=size||from_index>to_index) return;
+    if(to_index>=size) to_index = size-1;
+
+    for(size_t i = from_index; i<=to_index; i++) this->_events_id_map.erase(this->_events[i].id);
     this->_events.erase(from_index,to_index);
+    this->_event_dispatch_index_needs_rebuild = 1;
+    this->_update_events_id_map(from_index);
     return;
 }
 void cSDL_ButtonsManager::delete_buttons(uint32_t id)
 {
-    bool does_id_exists1 = 0;
-    size_t size1 = this->_buttons.size();
-    for(size_t i = 0; i<size1; i++)
-    {
-        if(this->_buttons[i].id==id)
-        {
-            does_id_exists1 = 1;
-            this->_buttons.erase(i,i);
-            break;
-        }
-    }
-    if(does_id_exists1==0) return;
+    const size_t index = this->_find_button_index(id);
+    if(index==0xFFFFFFFF) return;
 
-    if(this->_actual_button_index_focus!=0xFFFFFFFF)
+    this->_buttons_id_map.erase(id);
+    this->_buttons[index].id = 0;
+    _deleted_tree_mark(this->_deleted_buttons_tree,this->_count_of_deleted_buttons,this->_buttons.size(),index);
+    this->_count_of_deleted_buttons++;
+    if(this->_actual_button_id_focus==id)
     {
-        bool does_id_exists = 0;
-        size_t size = this->_buttons.size();
-        size_t i = 0;
-        for(; i<size; i++)
-        {
-            if(this->_buttons[i].id==this->_actual_button_id_focus)
-            {
-                does_id_exists = 1;
-                this->_actual_button_index_focus = i;
-                break;
-            }
-        }
-        if(does_id_exists==0)
-        {
-            this->_actual_button_id_focus = 0;
-            this->_actual_button_index_focus = 0xFFFFFFFF;
-        }
+        this->_actual_button_id_focus = 0;
+        this->_actual_button_index_focus = 0xFFFFFFFF;
     }
     return;
 }
 void cSDL_ButtonsManager::delete_events(uint32_t id)
 {
-    size_t size = this->_events.size();
-    size_t i = 0;
-    for(; i<size; i++)
-    {
-        if(this->_events[i].id==id)
-        {
-            this->_events.erase(i,i);
-            break;
-        }
-    }
+    const size_t index = this->_find_event_index(id);
+    if(index==0xFFFFFFFF) return;
 
+    this->_events_id_map.erase(id);
+    this->_events[index].id = 0;
+    _deleted_tree_mark(this->_deleted_events_tree,this->_count_of_deleted_events,this->_events.size(),index);
+    this->_count_of_deleted_events++;
+    this->_event_dispatch_index_needs_rebuild = 1;
     return;
 }
 void cSDL_ButtonsManager::delete_all_events()
 {
     this->_events.clear();
+    this->_count_of_deleted_events = 0;
+    this->_event_dispatch_index_needs_rebuild = 1;
+    this->_events_id_map.clear();
+    this->_events_id_map_needs_rebuild = 0;
     return;
 }
 void cSDL_ButtonsManager::delete_all_buttons()
 {
     this->_buttons.clear();
+    this->_count_of_deleted_buttons = 0;
+    this->_buttons_id_map.clear();
+    this->_buttons_id_map_needs_rebuild = 0;
+    this->_actual_button_index_focus_needs_update = 0;
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+    this->_button_arrays_need_rebuild = 1;   // arrays are empty after rebuild so it costs nothing;
     this->_actual_button_id_focus = 0;
     this->_actual_button_index_focus = 0xFFFFFFFF;
     return;
@@ -2820,7 +3778,9 @@ void cSDL_ButtonsManager::delete_all_buttons()
 
 size_t cSDL_ButtonsManager::get_focused_button_index() const
 {
-    return this->_actual_button_index_focus;
+    if(this->_actual_button_index_focus_needs_update==1) return this->get_button_index(this->_actual_button_id_focus);
+    if(this->_actual_button_index_focus==0xFFFFFFFF) return 0xFFFFFFFF;
+    return this->_get_index_without_deleted_buttons(this->_actual_button_index_focus);
 }
 uint32_t cSDL_ButtonsManager::get_focused_button_id() const
 {
@@ -2829,46 +3789,31 @@ uint32_t cSDL_ButtonsManager::get_focused_button_id() const
 
 uint32_t cSDL_ButtonsManager::get_focused_button_user_custom_data() const
 {
-    if(this->_actual_button_index_focus==0xFFFFFFFF) return 0xFFFFFFFF;
-    else return this->_buttons[this->_actual_button_index_focus].user_custom_data;
+    size_t index = this->_actual_button_index_focus;
+    if(this->_actual_button_index_focus_needs_update==1) index = this->_find_button_index(this->_actual_button_id_focus);
+    if(index==0xFFFFFFFF) return 0xFFFFFFFF;
+    else return this->_buttons[index].user_custom_data;
 }
 
 size_t cSDL_ButtonsManager::get_button_index(uint32_t id) const
 {
-    size_t returned_index = 0xFFFFFFFF;
-    size_t size = this->_buttons.size();
-
-    for(size_t i = 0; i<size; i++)
-    {
-        if(this->_buttons[i].id==id)
-        {
-            returned_index = i;
-            break;
-        }
-    }
-
-    return returned_index;
+    const size_t index = this->_find_button_index(id);
+    if(index==0xFFFFFFFF) return 0xFFFFFFFF;
+    return this->_get_index_without_deleted_buttons(index);
 }
 
 size_t cSDL_ButtonsManager::get_event_index(uint32_t id) const
 {
-    size_t returned_index = 0xFFFFFFFF;
-    size_t size = this->_events.size();
-
-    for(size_t i = 0; i<size; i++)
-    {
-        if(this->_events[i].id==id)
-        {
-            returned_index = i;
-            break;
-        }
-    }
-
-    return returned_index;
+    const size_t index = this->_find_event_index(id);
+    if(index==0xFFFFFFFF) return 0xFFFFFFFF;
+    return this->_get_index_without_deleted_events(index);
 }
 
 void cSDL_ButtonsManager::run_event_checker(SDL_Event* event)
 {
+    this->_remove_deleted_buttons();
+    this->_remove_deleted_events();
+
     bool check_mouse_position = 0;
     bool update_forcefully_mouse_position = 0;
     if(this->_check_mouse_motion_only_in_force_mouse_position_event_update==0) check_mouse_position = 1;
@@ -2970,503 +3915,1176 @@ void cSDL_ButtonsManager::run_event_checker(SDL_Event* event)
 
 
 
-//      check here mouse motion if it captures focus by moving;
-    if(check_mouse_position==1)
+//      check here mouse motion if it captures focus by moving;
+    if(check_mouse_position==1)
+    {
+        int32_t mouse_x,mouse_y;
+        bool check_mouse = 0;
+        if(update_forcefully_mouse_position==1)
+        {
+            // set mouse_x and mouse_y through SDL function SDL_GetMouseState;
+            SDL_GetMouseState(&mouse_x,&mouse_y);
+            check_mouse = 1;
+        }
+        else
+        {
+            // set mouse_x and mouse_y through "event";
+            if(event->type==SDL_MOUSEMOTION)
+            {
+                mouse_x = event->motion.x;
+                mouse_y = event->motion.y;
+                check_mouse = 1;
+            }
+        }
+
+        if(check_mouse==1)
+        {
+            if(this->_actual_button_index_focus!=0xFFFFFFFF&&this->_actual_device_focus==FocusType::MOUSE)
+            {
+                this->_actual_button_id_focus = 0;
+                this->_actual_button_index_focus = 0xFFFFFFFF;
+            }
+
+            int64_t i = this->_find_button_at_position(mouse_x,mouse_y);
+            if(i!=-1)
+            {
+                this->_actual_button_id_focus = this->_buttons[i].id;
+                this->_actual_button_index_focus = i;
+                this->_actual_device_focus = FocusType::MOUSE;
+            }
+        }
+
+    }
+
+
+    if(this->_event_dispatch_index_needs_rebuild==1) this->_rebuild_event_dispatch_index();
+
+    if(this->_count_of_events_ready_without_input!=0)
+    {
+        // there's at least 1 event that can be completed by any SDL event (event without requirements or with only held "HOLD_DOWN_COMBINATION" keys)
+        //      so every event has to be checked in order like without dispatch index;
+        size_t event_count = this->_events.size();
+        for(size_t i = 0; i<event_count; i++)
+        {
+            if(this->_check_event_requirements(i,event)==1)
+            {
+                this->_activate_event(i,event);
+                break;
+            }
+        }
+        return;
+    }
+
+    // only events that have requirement for this key/mouse button or for this type of SDL event are checked;
+    //      both lists are sorted from the lowest index of event so merging them keeps the order of checking events;
+    uint32_t first_a = 0,last_a = 0,first_b = 0,last_b = 0;
+    if(event->type==SDL_KEYDOWN||event->type==SDL_KEYUP) this->_get_event_dispatch_list(this->_event_dispatch_keys_map,event->key.keysym.sym,first_a,last_a);
+    else if(event->type==SDL_MOUSEBUTTONDOWN||event->type==SDL_MOUSEBUTTONUP) this->_get_event_dispatch_list(this->_event_dispatch_mouse_map,event->button.button,first_a,last_a);
+    this->_get_event_dispatch_list(this->_event_dispatch_special_map,event->type,first_b,last_b);
+
+    while(first_a<last_a||first_b<last_b)
+    {
+        uint32_t i;
+        if(first_b>=last_b||(first_a<last_a&&this->_event_dispatch_events[first_a]<=this->_event_dispatch_events[first_b]))
+        {
+            i = this->_event_dispatch_events[first_a];
+            first_a++;
+            if(first_b<last_b&&this->_event_dispatch_events[first_b]==i) first_b++;
+        }
+        else
+        {
+            i = this->_event_dispatch_events[first_b];
+            first_b++;
+        }
+
+        if(this->_check_event_requirements(i,event)==1)
+        {
+            this->_activate_event(i,event);
+            break;
+        }
+    }
+
+    return;
+}
+
+void cSDL_ButtonsManager::run_event_checker_batch(const SDL_Event* events,size_t count)
+{
+    SDL_Event event;
+    size_t i = 0;
+    while(i<count)
+    {
+        if(events[i].type!=SDL_MOUSEMOTION||this->_event_dispatch_reacts_to_type(SDL_MOUSEMOTION)==1)
+        {
+            event = events[i];
+            this->run_event_checker(&event);
+            i++;
+            continue;
+        }
+
+        // run of mouse motions that can only change focus of button; no callback can be called between them so state of buttons doesn't change;
+        size_t end_of_run = i+1;
+        while(end_of_run<count&&events[end_of_run].type==SDL_MOUSEMOTION) end_of_run++;
+
+        // until mouse has focus,motion that doesn't hit any button changes nothing so every motion has to be checked;
+        //      after that every motion drops focus and sets it again so only the last one matters;
+        if(this->_check_mouse_motion_only_in_force_mouse_position_event_update==0)
+        {
+            while(i<end_of_run-1&&this->_actual_device_focus!=FocusType::MOUSE)
+            {
+                event = events[i];
+                this->run_event_checker(&event);
+                i++;
+            }
+        }
+        event = events[end_of_run-1];
+        this->run_event_checker(&event);
+        i = end_of_run;
+    }
+    return;
+}
+
+bool cSDL_ButtonsManager::_event_dispatch_reacts_to_type(uint32_t type)
+{
+    this->_remove_deleted_events();
+    if(this->_event_dispatch_index_needs_rebuild==1) this->_rebuild_event_dispatch_index();
+    if(this->_count_of_events_ready_without_input!=0) return 1;
+    if(this->_event_dispatch_special_map.find(type)!=0xFFFFFFFF) return 1;
+    return 0;
+}
+
+bool cSDL_ButtonsManager::_check_event_requirements(size_t i,SDL_Event* event)
+{
+    const size_t k_size = this->_events[i].k_events.size();
+    const size_t m_size = this->_events[i].m_events.size();
+    const size_t s_size = this->_events[i].s_events.size();
+    size_t parts_of_event_to_complete = 0;
+
+    for(size_t j = 0; j<k_size; j++)
+    {
+        if((event->type==SDL_KEYDOWN||event->type==SDL_KEYUP)&&event->key.keysym.sym==this->_events[i].k_events[j].key)
+        {
+            if(event->type==SDL_KEYDOWN)
+            {
+                if((this->_events[i].k_events[j].type==TypeOfPress::DOWN||this->_events[i].k_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION)&&event->key.repeat==0)
+                {
+                    // set that this part of event is completed;
+                    parts_of_event_to_complete++;
+                }
+
+                this->_events[i].k_events[j].last_pressed_focused_button_id = this->_actual_button_id_focus;    // important only if u choose "DOWN_UP" of "this->_events[i].k_events[j].type"
+                this->_events[i].k_events[j].pressing_down = 1;
+            }
+            else if(event->type==SDL_KEYUP)
+            {
+                if(this->_events[i].k_events[j].type==TypeOfPress::UP)
+                {
+                    // set that this part of event is completed;
+                    parts_of_event_to_complete++;
+                }
+                else if(this->_events[i].k_events[j].type==TypeOfPress::DOWN_UP)
+                {
+                    if(this->_events[i].k_events[j].pressing_down==1&&this->_events[i].k_events[j].last_pressed_focused_button_id==this->_actual_button_id_focus)
+                    {
+                        // set that this part of event is completed;
+                        parts_of_event_to_complete++;
+                    }
+                    this->_events[i].k_events[j].last_pressed_focused_button_id = 0;    // important only if u choose "DOWN_UP" of "this->_events[i].k_events[j].type"
+                }
+                this->_events[i].k_events[j].pressing_down = 0;
+            }
+        }
+        else if(this->_events[i].k_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION&&this->_events[i].k_events[j].pressing_down==1)
+        {
+            parts_of_event_to_complete++;
+        }
+    }
+
+    for(size_t j = 0; j<m_size; j++)
+    {
+        if((event->type==SDL_MOUSEBUTTONDOWN||event->type==SDL_MOUSEBUTTONUP)&&event->button.button==this->_events[i].m_events[j].mouse_key)
+        {
+            if(event->type==SDL_MOUSEBUTTONDOWN)
+            {
+                if(this->_events[i].m_events[j].type==TypeOfPress::DOWN||this->_events[i].m_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION)
+                {
+                    // set that this part of event is completed;
+                    parts_of_event_to_complete++;
+                }
+
+                this->_events[i].m_events[j].last_pressed_focused_button_id = this->_actual_button_id_focus; // important only if u choose "DOWN_UP" of "this->_events[i].m_events[j].type"
+                this->_events[i].m_events[j].pressing_down = 1;
+            }
+            else if(event->type==SDL_MOUSEBUTTONUP)
+            {
+                if(this->_events[i].m_events[j].type==TypeOfPress::UP)
+                {
+                    // set that this part of event is completed;
+                    parts_of_event_to_complete++;
+                }
+                else if(this->_events[i].m_events[j].type==TypeOfPress::DOWN_UP)
+                {
+                    if(this->_events[i].m_events[j].pressing_down==1&&this->_events[i].m_events[j].last_pressed_focused_button_id==this->_actual_button_id_focus)
+                    {
+                        // set that this part of event is completed;
+                        parts_of_event_to_complete++;
+                    }
+                    this->_events[i].m_events[j].last_pressed_focused_button_id = 0;    // important only if u choose "DOWN_UP" of "this->_events[i].m_events[j].type"
+                }
+                this->_events[i].m_events[j].pressing_down = 0;
+            }
+        }
+        else if(this->_events[i].m_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION&&this->_events[i].m_events[j].pressing_down==1)
+        {
+            parts_of_event_to_complete++;
+        }
+    }
+
+    for(size_t j = 0; j<s_size; j++)
+    {
+        if(event->type==this->_events[i].s_events[j].type)
+        {
+            // set that this part of event is complete;
+            parts_of_event_to_complete++;
+        }
+    }
+    this->_update_event_dispatch_state(i);
+
+    return parts_of_event_to_complete==(k_size+m_size+s_size);
+}
+
+void cSDL_ButtonsManager::_rebuild_event_dispatch_index()
+{
+    this->_event_dispatch_index_needs_rebuild = 0;
+    this->_event_dispatch_keys_map.clear();
+    this->_event_dispatch_mouse_map.clear();
+    this->_event_dispatch_special_map.clear();
+    this->_event_dispatch_lists_start.clear();
+    this->_event_dispatch_events.clear();
+    this->_event_ready_without_input.clear();
+    this->_count_of_events_ready_without_input = 0;
+
+    // first pass gives number of list to every requirement and collects pairs (list,event); if the same event has a few requirements
+    //      with the same key then event is added to list only once;
+    struct Pair {uint32_t list; uint32_t event_index;};
+    CustomVector<Pair> pairs;
+    CustomVector<uint32_t> last_event_of_list;      // it's for skipping duplicates;
+    const size_t event_count = this->_events.size();
+    this->_event_ready_without_input.reserve(event_count);
+    for(size_t i = 0; i<event_count; i++)
+    {
+        this->_event_ready_without_input.push_back(0);
+        this->_update_event_dispatch_state(i);
+
+        const size_t k_size = this->_events[i].k_events.size();
+        const size_t m_size = this->_events[i].m_events.size();
+        const size_t s_size = this->_events[i].s_events.size();
+        const size_t count_of_requirements = k_size+m_size+s_size;
+        for(size_t j = 0; j<count_of_requirements; j++)
+        {
+            CustomIdMap* map;
+            uint32_t key;
+            if(j<k_size) {map = &this->_event_dispatch_keys_map; key = this->_events[i].k_events[j].key;}
+            else if(j<k_size+m_size) {map = &this->_event_dispatch_mouse_map; key = this->_events[i].m_events[j-k_size].mouse_key;}
+            else {map = &this->_event_dispatch_special_map; key = this->_events[i].s_events[j-k_size-m_size].type;}
+
+            uint32_t list = map->find(key);
+            if(list==0xFFFFFFFF)
+            {
+                list = last_event_of_list.size();
+                map->insert(key,list);
+                last_event_of_list.push_back(0xFFFFFFFF);
+            }
+            if(last_event_of_list[list]==i) continue;
+            last_event_of_list[list] = i;
+
+            Pair pair; pair.list = list; pair.event_index = i;
+            pairs.push_back(pair);
+        }
+    }
+
+    // second pass sorts pairs by lists (counting sort); pairs are already sorted by events so every list stays sorted;
+    const size_t count_of_lists = last_event_of_list.size();
+    const size_t count_of_pairs = pairs.size();
+    this->_event_dispatch_lists_start.reserve(count_of_lists+1);
+    for(size_t l = 0; l<=count_of_lists; l++) this->_event_dispatch_lists_start.push_back(0);
+    for(size_t p = 0; p<count_of_pairs; p++) this->_event_dispatch_lists_start[pairs[p].list+1]++;
+    for(size_t l = 0; l<count_of_lists; l++) this->_event_dispatch_lists_start[l+1]+=this->_event_dispatch_lists_start[l];
+
+    this->_event_dispatch_events.reserve(count_of_pairs);
+    for(size_t p = 0; p<count_of_pairs; p++) this->_event_dispatch_events.push_back(0);
+    for(size_t l = 0; l<count_of_lists; l++) last_event_of_list[l] = this->_event_dispatch_lists_start[l];     // used now as position to write;
+    for(size_t p = 0; p<count_of_pairs; p++)
+    {
+        this->_event_dispatch_events[last_event_of_list[pairs[p].list]] = pairs[p].event_index;
+        last_event_of_list[pairs[p].list]++;
+    }
+
+    return;
+}
+
+void cSDL_ButtonsManager::_get_event_dispatch_list(const CustomIdMap& map,uint32_t key,uint32_t& first,uint32_t& last) const
+{
+    const uint32_t list = map.find(key);
+    if(list==0xFFFFFFFF)
+    {
+        first = 0;
+        last = 0;
+    }
+    else
+    {
+        first = this->_event_dispatch_lists_start[list];
+        last = this->_event_dispatch_lists_start[list+1];
+    }
+    return;
+}
+
+void cSDL_ButtonsManager::_update_event_dispatch_state(size_t i)
+{
+    bool ready = (this->_events[i].s_events.size()==0);   // special requirements are met only by its own type of SDL event;
+
+    const size_t k_size = this->_events[i].k_events.size();
+    for(size_t j = 0; j<k_size&&ready==1; j++)
+    {
+        if(this->_events[i].k_events[j].type!=TypeOfPress::HOLD_DOWN_COMBINATION||this->_events[i].k_events[j].pressing_down==0) ready = 0;
+    }
+    const size_t m_size = this->_events[i].m_events.size();
+    for(size_t j = 0; j<m_size&&ready==1; j++)
+    {
+        if(this->_events[i].m_events[j].type!=TypeOfPress::HOLD_DOWN_COMBINATION||this->_events[i].m_events[j].pressing_down==0) ready = 0;
+    }
+
+    if(ready!=this->_event_ready_without_input[i])
+    {
+        this->_event_ready_without_input[i] = ready;
+        if(ready==1) this->_count_of_events_ready_without_input++;
+        else this->_count_of_events_ready_without_input--;
+    }
+    return;
+}
+
+void cSDL_ButtonsManager::_activate_event(size_t i,SDL_Event* event)
+{
+    if(this->_events[i].default_button_focus_id!=0&&this->_actual_button_id_focus==0)   // if default button option is ON;
+    {
+        size_t count_of_buttons = this->_buttons.size();
+        const size_t j = this->_find_button_index(this->_events[i].default_button_focus_id);
+        if(j!=0xFFFFFFFF)
+        {
+            this->_actual_button_id_focus = this->_buttons[j].id;
+            this->_actual_button_index_focus = j;
+        }
+        else
+        {
+            if(count_of_buttons!=0)
+            {
+                this->_actual_button_id_focus = this->_buttons[0].id;
+                this->_actual_button_index_focus = 0;
+            }
+            else
+            {
+                this->_actual_button_id_focus = 0;
+                this->_actual_button_index_focus = 0xFFFFFFFF;
+            }
+        }
+    }
+    else if(this->_events[i].focus_interaction_area.w!=-1&&this->_actual_button_index_focus!=0xFFFFFFFF)  // if "auto focus changing" mechanism is ON;
+    {
+        int64_t nearest_button_index = this->_find_button_in_direction(this->_events[i].main_focus_interaction,this->_events[i].max_perpendicular_difference);
+        if(nearest_button_index==-1)
+        {
+            nearest_button_index = this->_find_button_in_direction(this->_events[i].addtional_focus_interaction,this->_events[i].max_perpendicular_difference_additional);
+        }
+
+        if(nearest_button_index!=-1)
+        {
+            this->_actual_button_index_focus = nearest_button_index;
+            this->_actual_button_id_focus = this->_buttons[nearest_button_index].id;
+        }
+
+    }
+
+    if(this->_events[i].callable_invoker!=NULL)
+    {
+        // callable is called on its copy 'cause callback can create events and "_events" can be moved to other memory while callable works;
+        alignas(16) unsigned char callable[CSDL_EVENT_CALLABLE_SIZE];
+        memcpy(callable,this->_events[i].callable_storage,CSDL_EVENT_CALLABLE_SIZE);
+        this->_events[i].callable_invoker(callable,event,this);
+    }
+    else this->_events[i].activated_func(this->_events[i].user_data,event,this);
+    return;
+}
+
+size_t cSDL_ButtonsManager::_find_button_index(uint32_t id) const
+{
+    if(id==0) return 0xFFFFFFFF;
+    if(this->_buttons_id_map_needs_rebuild==1) this->_rebuild_buttons_id_map();
+    const uint32_t index = this->_buttons_id_map.find(id);
+    if(index==0xFFFFFFFF||index>=this->_buttons.size()||this->_buttons[index].id!=id) return 0xFFFFFFFF;
+    return index;
+}
+
+size_t cSDL_ButtonsManager::_find_event_index(uint32_t id) const
+{
+    if(id==0) return 0xFFFFFFFF;
+    if(this->_events_id_map_needs_rebuild==1) this->_rebuild_events_id_map();
+    const uint32_t index = this->_events_id_map.find(id);
+    if(index==0xFFFFFFFF||index>=this->_events.size()||this->_events[index].id!=id) return 0xFFFFFFFF;
+    return index;
+}
+
+void cSDL_ButtonsManager::_update_buttons_id_map(size_t first_index)
+{
+    const size_t size = this->_buttons.size();
+    for(size_t i = first_index; i<size; i++) this->_buttons_id_map.insert(this->_buttons[i].id,i);
+    return;
+}
+
+void cSDL_ButtonsManager::_update_events_id_map(size_t first_index)
+{
+    const size_t size = this->_events.size();
+    for(size_t i = first_index; i<size; i++) this->_events_id_map.insert(this->_events[i].id,i);
+    return;
+}
+
+void cSDL_ButtonsManager::_rebuild_buttons_id_map() const
+{
+    this->_buttons_id_map_needs_rebuild = 0;
+    this->_buttons_id_map.clear();
+    const size_t size = this->_buttons.size();
+    for(size_t i = 0; i<size; i++) if(this->_buttons[i].id!=0) this->_buttons_id_map.insert(this->_buttons[i].id,i);
+    return;
+}
+
+void cSDL_ButtonsManager::_rebuild_events_id_map() const
+{
+    this->_events_id_map_needs_rebuild = 0;
+    this->_events_id_map.clear();
+    const size_t size = this->_events.size();
+    for(size_t i = 0; i<size; i++) if(this->_events[i].id!=0) this->_events_id_map.insert(this->_events[i].id,i);
+    return;
+}
+
+void cSDL_ButtonsManager::_invalidate_buttons_caches()
+{
+    this->_remove_deleted_buttons();
+    this->_buttons_id_map_needs_rebuild = 1;
+    this->_actual_button_index_focus_needs_update = 1;
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+    this->_button_arrays_need_rebuild = 1;
+    return;
+}
+
+void cSDL_ButtonsManager::_invalidate_events_caches()
+{
+    this->_remove_deleted_events();
+    this->_events_id_map_needs_rebuild = 1;
+    this->_event_dispatch_index_needs_rebuild = 1;
+    return;
+}
+
+void cSDL_ButtonsManager::_remove_deleted_buttons()
+{
+    if(this->_actual_button_index_focus_needs_update==1)
+    {
+        this->_actual_button_index_focus_needs_update = 0;
+        this->_actual_button_index_focus = this->_find_button_index(this->_actual_button_id_focus);
+        if(this->_actual_button_index_focus==0xFFFFFFFF) this->_actual_button_id_focus = 0;
+    }
+    if(this->_count_of_deleted_buttons==0) return;
+    this->_count_of_deleted_buttons = 0;
+
+    const size_t size = this->_buttons.size();
+    const bool update_arrays = (this->_button_arrays_need_rebuild==0);
+    size_t first_deleted = 0;
+    while(this->_buttons[first_deleted].id!=0) first_deleted++;
+
+    size_t new_size = first_deleted;
+    for(size_t i = first_deleted+1; i<size; i++)
+    {
+        if(this->_buttons[i].id==0) continue;
+        this->_buttons[new_size] = this->_buttons[i];
+        if(update_arrays==1)
+        {
+            this->_button_x[new_size] = this->_button_x[i]; this->_button_y[new_size] = this->_button_y[i];
+            this->_button_w[new_size] = this->_button_w[i]; this->_button_h[new_size] = this->_button_h[i];
+            this->_button_gain_focus_mask[new_size] = this->_button_gain_focus_mask[i];
+        }
+        new_size++;
+    }
+    this->_buttons.erase(new_size,size-1);
+    if(update_arrays==1)
+    {
+        this->_button_x.erase(new_size,size-1); this->_button_y.erase(new_size,size-1);
+        this->_button_w.erase(new_size,size-1); this->_button_h.erase(new_size,size-1);
+        this->_button_gain_focus_mask.erase(new_size,size-1);
+    }
+    this->_update_buttons_id_map(first_deleted);
+    this->_spatial_index_needs_rebuild = 1;
+    this->_navigation_index_needs_rebuild = 1;
+
+    if(this->_actual_button_index_focus!=0xFFFFFFFF)
+    {
+        this->_actual_button_index_focus = this->_find_button_index(this->_actual_button_id_focus);
+        if(this->_actual_button_index_focus==0xFFFFFFFF) this->_actual_button_id_focus = 0;
+    }
+    return;
+}
+
+void cSDL_ButtonsManager::_remove_deleted_events()
+{
+    if(this->_count_of_deleted_events==0) return;
+    this->_count_of_deleted_events = 0;
+
+    size_t first_deleted = 0;
+    while(this->_events[first_deleted].id!=0) first_deleted++;
+
+    this->_events.erase_if([](const Event& event){return event.id==0;});   // one pass moving only events that are after deleted ones;
+    this->_update_events_id_map(first_deleted);
+    this->_event_dispatch_index_needs_rebuild = 1;
+    return;
+}
+
+size_t cSDL_ButtonsManager::_get_index_without_deleted_buttons(size_t index) const
+{
+    if(this->_count_of_deleted_buttons==0) return index;
+    return index-_deleted_tree_prefix(this->_deleted_buttons_tree,index);
+}
+
+size_t cSDL_ButtonsManager::_get_index_without_deleted_events(size_t index) const
+{
+    if(this->_count_of_deleted_events==0) return index;
+    return index-_deleted_tree_prefix(this->_deleted_events_tree,index);
+}
+
+void cSDL_ButtonsManager::_deleted_tree_mark(CustomVector<uint32_t>& tree,size_t count_of_deleted,size_t size,size_t index)
+{
+    if(count_of_deleted==0)     // tree from previous deleting is outdated;
+    {
+        tree.clear();
+        tree.reserve(size);
+        for(size_t i = 0; i<size; i++) tree.push_back(0);
+    }
+    for(size_t i = index+1; i<=tree.size(); i+=i&(~i+1)) tree[i-1]++;
+    return;
+}
+
+void cSDL_ButtonsManager::_deleted_tree_push_back(CustomVector<uint32_t>& tree)
+{
+    // node 'k' (counted from 1) keeps sum of elements (k-lowbit(k),k]; new element isn't deleted so it's sum of the rest of its range;
+    const size_t k = tree.size()+1;
+    const uint32_t sum = (uint32_t)(_deleted_tree_prefix(tree,k-1)-_deleted_tree_prefix(tree,k-(k&(~k+1))));
+    tree.push_back(sum);
+    return;
+}
+
+size_t cSDL_ButtonsManager::_deleted_tree_prefix(const CustomVector<uint32_t>& tree,size_t count)
+{
+    if(count>tree.size()) count = tree.size();  // elements added to vector by user (through "get_button_vector()") aren't deleted;
+    size_t sum = 0;
+    for(size_t i = count; i>0; i-=i&(~i+1)) sum+=tree[i-1];
+    return sum;
+}
+
+SDL_Rect cSDL_ButtonsManager::_get_button_hitbox(size_t index) const
+{
+    SDL_Rect dimensions = this->_buttons[index].button_dimensions;
+    if(this->_do_buttons_scals_with_window_w_h==1)
+    {
+        dimensions.x*=this->_scale_button_dimensions_x;
+        dimensions.w*=this->_scale_button_dimensions_x;
+        dimensions.y*=this->_scale_button_dimensions_y;
+        dimensions.h*=this->_scale_button_dimensions_y;
+    }
+    return dimensions;
+}
+
+int64_t cSDL_ButtonsManager::_find_button_at_position(int32_t x,int32_t y)
+{
+    if(this->_button_arrays_need_rebuild==1) this->_rebuild_button_arrays();
+
+    if(this->_use_spatial_index==1)
+    {
+        if(this->_spatial_index_needs_rebuild==1) this->_rebuild_spatial_index();
+
+        if(x<this->_spatial_index_x||y<this->_spatial_index_y) return -1;
+        const int64_t column = ((int64_t)x-this->_spatial_index_x)/this->_spatial_index_actual_cell_size;
+        const int64_t row = ((int64_t)y-this->_spatial_index_y)/this->_spatial_index_actual_cell_size;
+        if(column>=this->_spatial_index_columns||row>=this->_spatial_index_rows) return -1;
+
+        // indexes in cell are sorted from the lowest so checking from the end keeps rule that the last button in vector is the most upper;
+        int64_t found = -1;
+        const size_t cell = row*this->_spatial_index_columns+column;
+        const uint32_t first = this->_spatial_index_cell_start[cell];
+        for(uint32_t j = this->_spatial_index_cell_start[cell+1]; j>first; j--)
+        {
+            const uint32_t i = this->_spatial_index_buttons[j-1];
+            const int32_t right = (int32_t)((uint32_t)this->_button_x[i]+(uint32_t)this->_button_w[i]);
+            const int32_t bottom = (int32_t)((uint32_t)this->_button_y[i]+(uint32_t)this->_button_h[i]);
+            if((x>=this->_button_x[i]&&x<=right)&&(y>=this->_button_y[i]&&y<=bottom))
+            {
+                found = i;
+                break;
+            }
+        }
+        // large buttons are checked only above the button found in cell 'cause lower ones are under it; list is sorted so they're at its end;
+        const size_t count_of_large = this->_spatial_index_large_buttons.size();
+        size_t low = 0,high = count_of_large;
+        while(low<high)
+        {
+            const size_t middle = (low+high)/2;
+            if((int64_t)this->_spatial_index_large_buttons[middle]>found) high = middle;
+            else low = middle+1;
+        }
+        if(low<count_of_large)
+        {
+            const int64_t j = _find_last_rect_containing_point(&this->_spatial_index_large_x[low],&this->_spatial_index_large_y[low],&this->_spatial_index_large_w[low],
+                                                                &this->_spatial_index_large_h[low],&this->_spatial_index_large_mask[low],count_of_large-low,x,y);
+            if(j!=-1) return this->_spatial_index_large_buttons[low+j];
+        }
+        return found;
+    }
+
+    if(this->_buttons.size()==0) return -1;
+    return _find_last_rect_containing_point(&this->_button_x[0],&this->_button_y[0],&this->_button_w[0],&this->_button_h[0],
+                                            &this->_button_gain_focus_mask[0],this->_buttons.size(),x,y);
+}
+
+void cSDL_ButtonsManager::_rebuild_spatial_index()
+{
+    this->_spatial_index_needs_rebuild = 0;
+    this->_spatial_index_cell_start.clear();
+    this->_spatial_index_buttons.clear();
+    this->_spatial_index_large_buttons.clear();
+    this->_spatial_index_large_x.clear(); this->_spatial_index_large_y.clear();
+    this->_spatial_index_large_w.clear(); this->_spatial_index_large_h.clear();
+    this->_spatial_index_large_mask.clear();
+    this->_spatial_index_columns = 0;
+    this->_spatial_index_rows = 0;
+
+    // bounds of every button that can gain focus by cursor; buttons with negative "w" or "h" can't be pointed so they are skipped;
+    const size_t count_of_buttons = this->_buttons.size();
+    size_t count_of_indexed_buttons = 0;
+    int64_t min_x = 0,min_y = 0,max_x = 0,max_y = 0;
+    for(size_t i = 0; i<count_of_buttons; i++)
+    {
+        if(this->_button_gain_focus_mask[i]==0) continue;
+        const SDL_Rect dimensions = {this->_button_x[i],this->_button_y[i],this->_button_w[i],this->_button_h[i]};
+        if(dimensions.w<0||dimensions.h<0) continue;
+
+        const int64_t right = (int64_t)dimensions.x+dimensions.w;
+        const int64_t bottom = (int64_t)dimensions.y+dimensions.h;
+        if(count_of_indexed_buttons==0)
+        {
+            min_x = dimensions.x; min_y = dimensions.y;
+            max_x = right; max_y = bottom;
+        }
+        else
+        {
+            if(dimensions.x<min_x) min_x = dimensions.x;
+            if(dimensions.y<min_y) min_y = dimensions.y;
+            if(right>max_x) max_x = right;
+            if(bottom>max_y) max_y = bottom;
+        }
+        count_of_indexed_buttons++;
+    }
+    if(count_of_indexed_buttons==0) return;
+
+    // too many cells is only waste of memory so cell size is increased until there are at most ~4 cells for 1 button;
+    const int64_t max_count_of_cells = count_of_indexed_buttons*4+64;
+    int64_t cell_size = this->_spatial_index_cell_size;
+    int64_t columns,rows;
+    for(;;)
+    {
+        columns = (max_x-min_x)/cell_size+1;
+        rows = (max_y-min_y)/cell_size+1;
+        if(columns*rows<=max_count_of_cells) break;
+        cell_size*=2;
+    }
+    this->_spatial_index_actual_cell_size = cell_size;
+    this->_spatial_index_x = min_x;
+    this->_spatial_index_y = min_y;
+    this->_spatial_index_columns = columns;
+    this->_spatial_index_rows = rows;
+
+    const size_t count_of_cells = columns*rows;
+    this->_spatial_index_cell_start.reserve(count_of_cells+1);
+    for(size_t c = 0; c<=count_of_cells; c++) this->_spatial_index_cell_start.push_back(0);
+
+    // first pass counts buttons of every cell; after that "_spatial_index_cell_start[c]" is set to the end of cell 'c';
+    //      second pass goes from the last button and fills cells from their ends so at the finish every "_spatial_index_cell_start[c]"
+    //      points to the beginning of cell 'c' and indexes in every cell are sorted from the lowest;
+    for(int32_t pass = 0; pass<2; pass++)
+    {
+        for(size_t n = 0; n<count_of_buttons; n++)
+        {
+            const size_t i = (pass==0) ? n : count_of_buttons-1-n;
+            if(this->_button_gain_focus_mask[i]==0) continue;
+            const SDL_Rect dimensions = {this->_button_x[i],this->_button_y[i],this->_button_w[i],this->_button_h[i]};
+            if(dimensions.w<0||dimensions.h<0) continue;
+
+            const int64_t first_column = ((int64_t)dimensions.x-min_x)/cell_size;
+            const int64_t last_column = ((int64_t)dimensions.x+dimensions.w-min_x)/cell_size;
+            const int64_t first_row = ((int64_t)dimensions.y-min_y)/cell_size;
+            const int64_t last_row = ((int64_t)dimensions.y+dimensions.h-min_y)/cell_size;
+            if((last_column-first_column+1)*(last_row-first_row+1)>CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON)
+            {
+                if(pass==0)     // first pass goes from the lowest index so list is sorted;
+                {
+                    this->_spatial_index_large_buttons.push_back(i);
+                    this->_spatial_index_large_x.push_back(dimensions.x); this->_spatial_index_large_y.push_back(dimensions.y);
+                    this->_spatial_index_large_w.push_back(dimensions.w); this->_spatial_index_large_h.push_back(dimensions.h);
+                    this->_spatial_index_large_mask.push_back(-1);
+                }
+                continue;
+            }
+            for(int64_t row = first_row; row<=last_row; row++)
+            {
+                for(int64_t column = first_column; column<=last_column; column++)
+                {
+                    const size_t cell = row*columns+column;
+                    if(pass==0) this->_spatial_index_cell_start[cell]++;
+                    else
+                    {
+                        this->_spatial_index_cell_start[cell]--;
+                        this->_spatial_index_buttons[this->_spatial_index_cell_start[cell]] = i;
+                    }
+                }
+            }
+        }
+
+        if(pass==0)
+        {
+            size_t sum = 0;    // at most "count_of_buttons*CSDL_SPATIAL_INDEX_MAX_CELLS_PER_BUTTON";
+            for(size_t c = 0; c<count_of_cells; c++)
+            {
+                sum+=this->_spatial_index_cell_start[c];
+                this->_spatial_index_cell_start[c] = sum;
+            }
+            this->_spatial_index_cell_start[count_of_cells] = sum;
+            this->_spatial_index_buttons.reserve(sum);
+            for(size_t j = 0; j<sum; j++) this->_spatial_index_buttons.push_back(0);
+        }
+    }
+
+    return;
+}
+
+void cSDL_ButtonsManager::_rebuild_button_arrays()
+{
+    this->_button_arrays_need_rebuild = 0;
+    this->_button_x.clear(); this->_button_y.clear();
+    this->_button_w.clear(); this->_button_h.clear();
+    this->_button_gain_focus_mask.clear();
+
+    const size_t count_of_buttons = this->_buttons.size();
+    this->_button_x.reserve(count_of_buttons); this->_button_y.reserve(count_of_buttons);
+    this->_button_w.reserve(count_of_buttons); this->_button_h.reserve(count_of_buttons);
+    this->_button_gain_focus_mask.reserve(count_of_buttons);
+    for(size_t i = 0; i<count_of_buttons; i++) this->_write_button_arrays_entry(i);
+    return;
+}
+
+void cSDL_ButtonsManager::_write_button_arrays_entry(size_t i)
+{
+    const SDL_Rect dimensions = this->_get_button_hitbox(i);
+    const int32_t mask = (this->_buttons[i].gain_focus_by_mouse_cursor==1) ? -1 : 0;
+    if(i==this->_button_x.size())
+    {
+        this->_button_x.push_back(dimensions.x);
+        this->_button_y.push_back(dimensions.y);
+        this->_button_w.push_back(dimensions.w);
+        this->_button_h.push_back(dimensions.h);
+        this->_button_gain_focus_mask.push_back(mask);
+    }
+    else
+    {
+        this->_button_x[i] = dimensions.x;
+        this->_button_y[i] = dimensions.y;
+        this->_button_w[i] = dimensions.w;
+        this->_button_h[i] = dimensions.h;
+        this->_button_gain_focus_mask[i] = mask;
+    }
+    return;
+}
+
+int64_t cSDL_ButtonsManager::_find_last_rect_containing_point(const int32_t* x,const int32_t* y,const int32_t* w,const int32_t* h,const int32_t* mask,size_t count,int32_t point_x,int32_t point_y)
+{
+    // rects are checked from the end so the first found is the most upper one;
+    //      right/bottom edge is counted with wrapping like "x+w" of int32_t in scalar code;
+    size_t i = count;
+
+#if defined(CSDL_BUTTONS_HIT_TEST_AVX2)
+    const __m256i px = _mm256_set1_epi32(point_x);
+    const __m256i py = _mm256_set1_epi32(point_y);
+    while(i>=8)
+    {
+        i-=8;
+        const __m256i rx = _mm256_loadu_si256((const __m256i*)(x+i));
+        const __m256i ry = _mm256_loadu_si256((const __m256i*)(y+i));
+        const __m256i right = _mm256_add_epi32(rx,_mm256_loadu_si256((const __m256i*)(w+i)));
+        const __m256i bottom = _mm256_add_epi32(ry,_mm256_loadu_si256((const __m256i*)(h+i)));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(rx,px),_mm256_cmpgt_epi32(px,right));
+        outside = _mm256_or_si256(outside,_mm256_or_si256(_mm256_cmpgt_epi32(ry,py),_mm256_cmpgt_epi32(py,bottom)));
+        const __m256i hit = _mm256_andnot_si256(outside,_mm256_loadu_si256((const __m256i*)(mask+i)));
+        const int32_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(hit));
+        if(bits!=0)
+        {
+            for(int32_t b = 7; b>=0; b--) if((bits>>b)&1) return i+b;
+        }
+    }
+#elif defined(CSDL_BUTTONS_HIT_TEST_SSE2)
+    const __m128i px = _mm_set1_epi32(point_x);
+    const __m128i py = _mm_set1_epi32(point_y);
+    while(i>=4)
+    {
+        i-=4;
+        const __m128i rx = _mm_loadu_si128((const __m128i*)(x+i));
+        const __m128i ry = _mm_loadu_si128((const __m128i*)(y+i));
+        const __m128i right = _mm_add_epi32(rx,_mm_loadu_si128((const __m128i*)(w+i)));
+        const __m128i bottom = _mm_add_epi32(ry,_mm_loadu_si128((const __m128i*)(h+i)));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(rx,px),_mm_cmpgt_epi32(px,right));
+        outside = _mm_or_si128(outside,_mm_or_si128(_mm_cmpgt_epi32(ry,py),_mm_cmpgt_epi32(py,bottom)));
+        const __m128i hit = _mm_andnot_si128(outside,_mm_loadu_si128((const __m128i*)(mask+i)));
+        const int32_t bits = _mm_movemask_ps(_mm_castsi128_ps(hit));
+        if(bits!=0)
+        {
+            for(int32_t b = 3; b>=0; b--) if((bits>>b)&1) return i+b;
+        }
+    }
+#endif
+
+    while(i>0)
+    {
+        i--;
+        if(mask[i]==0) continue;
+        const int32_t right = (int32_t)((uint32_t)x[i]+(uint32_t)w[i]);
+        const int32_t bottom = (int32_t)((uint32_t)y[i]+(uint32_t)h[i]);
+        if((point_x>=x[i]&&point_x<=right)&&(point_y>=y[i]&&point_y<=bottom)) return i;
+    }
+    return -1;
+}
+
+cSDL_ButtonsManager::HitTestPath cSDL_ButtonsManager::get_hit_test_path()
+{
+#if defined(CSDL_BUTTONS_HIT_TEST_AVX2)
+    return HitTestPath::HIT_TEST_AVX2;
+#elif defined(CSDL_BUTTONS_HIT_TEST_SSE2)
+    return HitTestPath::HIT_TEST_SSE2;
+#else
+    return HitTestPath::HIT_TEST_SCALAR;
+#endif
+}
+
+void cSDL_ButtonsManager::_rebuild_navigation_index()
+{
+    this->_navigation_index_needs_rebuild = 0;
+    this->_navigation_sorted_by_x.clear();
+    this->_navigation_sorted_by_y.clear();
+    this->_navigation_x_levels.clear();
+    this->_navigation_y_levels.clear();
+    this->_navigation_count_of_buttons_without_width = 0;
+
+    const size_t count_of_buttons = this->_buttons.size();
+    this->_navigation_sorted_by_x.reserve(count_of_buttons);
+    this->_navigation_sorted_by_y.reserve(count_of_buttons);
+    for(size_t i = 0; i<count_of_buttons; i++)
     {
-        int32_t mouse_x,mouse_y;
-        bool check_mouse = 0;
-        if(update_forcefully_mouse_position==1)
-        {
-            // set mouse_x and mouse_y through SDL function SDL_GetMouseState;
-            SDL_GetMouseState(&mouse_x,&mouse_y);
-            check_mouse = 1;
-        }
-        else
-        {
-            // set mouse_x and mouse_y through "event";
-            if(event->type==SDL_MOUSEMOTION)
-            {
-                mouse_x = event->motion.x;
-                mouse_y = event->motion.y;
-                check_mouse = 1;
-            }
-        }
+        this->_navigation_sorted_by_x.push_back(i);
+        this->_navigation_sorted_by_y.push_back(i);
+        if(this->_buttons[i].button_dimensions.w==-1) this->_navigation_count_of_buttons_without_width++;
+    }
+    this->_sort_navigation_indexes(this->_navigation_sorted_by_x,0);
+    this->_sort_navigation_indexes(this->_navigation_sorted_by_y,1);
+
+    this->_navigation_levels_count = 1;
+    while(((size_t)1<<(this->_navigation_levels_count-1))<count_of_buttons) this->_navigation_levels_count++;
+    this->_navigation_x_levels.reserve(count_of_buttons*this->_navigation_levels_count);
+    this->_navigation_y_levels.reserve(count_of_buttons*this->_navigation_levels_count);
+    for(size_t n = 0; n<count_of_buttons; n++)
+    {
+        this->_navigation_x_levels.push_back(this->_buttons[this->_navigation_sorted_by_y[n]].button_dimensions.x);
+        this->_navigation_y_levels.push_back(this->_buttons[this->_navigation_sorted_by_x[n]].button_dimensions.y);
+    }
 
-        if(check_mouse==1)
+    // every next level merges pairs of neighbouring blocks of previous level;
+    for(size_t level = 1; level<this->_navigation_levels_count; level++)
+    {
+        const size_t half = (size_t)1<<(level-1);
+        const size_t previous = (level-1)*count_of_buttons;
+        for(int32_t axis = 0; axis<2; axis++)
         {
-            if(this->_actual_button_index_focus!=0xFFFFFFFF&&this->_actual_device_focus==FocusType::MOUSE)
-            {
-                this->_actual_button_id_focus = 0;
-                this->_actual_button_index_focus = 0xFFFFFFFF;
-            }
-
-            int64_t count_of_buttons = this->_buttons.size();
-            count_of_buttons--;
-            for(int64_t i = count_of_buttons; i>=0; i--)
+            CustomVector<int32_t>& levels = (axis==0) ? this->_navigation_x_levels : this->_navigation_y_levels;
+            for(size_t block = 0; block<count_of_buttons; block+=half*2)
             {
-                if(this->_buttons[i].gain_focus_by_mouse_cursor==1)
+                size_t left = block;
+                size_t right = block+half;
+                const size_t left_end = (right<count_of_buttons) ? right : count_of_buttons;
+                const size_t right_end = (block+half*2<count_of_buttons) ? block+half*2 : count_of_buttons;
+                while(left<left_end||right<right_end)
                 {
-                    SDL_Rect dimensions = this->_buttons[i].button_dimensions;
-                    if(this->_do_buttons_scals_with_window_w_h==1)
+                    if(right>=right_end||(left<left_end&&levels[previous+left]<=levels[previous+right]))
                     {
-                        dimensions.x*=this->_scale_button_dimensions_x;
-                        dimensions.w*=this->_scale_button_dimensions_x;
-                        dimensions.y*=this->_scale_button_dimensions_y;
-                        dimensions.h*=this->_scale_button_dimensions_y;
+                        levels.push_back(levels[previous+left]);
+                        left++;
                     }
-                    if((mouse_x>=dimensions.x&&mouse_x<=(dimensions.x+dimensions.w))&&(mouse_y>=dimensions.y&&mouse_y<=(dimensions.y+dimensions.h)))
+                    else
                     {
-                        this->_actual_button_id_focus = this->_buttons[i].id;
-                        this->_actual_button_index_focus = i;
-                        this->_actual_device_focus = FocusType::MOUSE;
-                        break;
+                        levels.push_back(levels[previous+right]);
+                        right++;
                     }
                 }
             }
         }
-
     }
+    return;
+}
 
+void cSDL_ButtonsManager::_sort_navigation_indexes(CustomVector<uint32_t>& indexes,bool by_y)
+{
+    // bottom-up merge sort; it's stable but index is compared anyway so order doesn't depend on it;
+    const size_t count = indexes.size();
+    CustomVector<uint32_t> buffer(count+1);
+    for(size_t n = 0; n<count; n++) buffer.push_back(0);
 
-    size_t event_count = this->_events.size();
-    for(size_t i = 0; i<event_count; i++)
+    CustomVector<uint32_t>* from = &indexes;
+    CustomVector<uint32_t>* to = &buffer;
+    for(size_t width = 1; width<count; width*=2)
     {
-        const size_t k_size = this->_events[i].k_events.size();
-        const size_t m_size = this->_events[i].m_events.size();
-        const size_t s_size = this->_events[i].s_events.size();
-        size_t parts_of_event_to_complete = 0;
-
-        for(size_t j = 0; j<k_size; j++)
+        for(size_t block = 0; block<count; block+=width*2)
         {
-            if(event->key.keysym.sym==this->_events[i].k_events[j].key)
+            size_t left = block;
+            size_t right = (block+width<count) ? block+width : count;
+            const size_t left_end = right;
+            const size_t right_end = (block+width*2<count) ? block+width*2 : count;
+            size_t out = block;
+            while(left<left_end||right<right_end)
             {
-                if(event->type==SDL_KEYDOWN)
-                {
-                    if((this->_events[i].k_events[j].type==TypeOfPress::DOWN||this->_events[i].k_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION)&&event->key.repeat==0)
-                    {
-                        // set that this part of event is completed;
-                        parts_of_event_to_complete++;
-                    }
-
-                    this->_events[i].k_events[j].last_pressed_focused_button_id = this->_actual_button_id_focus;    // important only if u choose "DOWN_UP" of "this->_events[i].k_events[j].type"
-                    this->_events[i].k_events[j].pressing_down = 1;
-                }
-                else if(event->type==SDL_KEYUP)
+                bool take_left = (right>=right_end);
+                if(take_left==0&&left<left_end)
                 {
-                    if(this->_events[i].k_events[j].type==TypeOfPress::UP)
-                    {
-                        // set that this part of event is completed;
-                        parts_of_event_to_complete++;
-                    }
-                    else if(this->_events[i].k_events[j].type==TypeOfPress::DOWN_UP)
-                    {
-                        if(this->_events[i].k_events[j].pressing_down==1&&this->_events[i].k_events[j].last_pressed_focused_button_id==this->_actual_button_id_focus)
-                        {
-                            // set that this part of event is completed;
-                            parts_of_event_to_complete++;
-                        }
-                        this->_events[i].k_events[j].last_pressed_focused_button_id = 0;    // important only if u choose "DOWN_UP" of "this->_events[i].k_events[j].type"
-                    }
-                    this->_events[i].k_events[j].pressing_down = 0;
+                    const SDL_Rect& a = this->_buttons[(*from)[left]].button_dimensions;
+                    const SDL_Rect& b = this->_buttons[(*from)[right]].button_dimensions;
+                    const int32_t a_main = (by_y==1) ? a.y : a.x;
+                    const int32_t b_main = (by_y==1) ? b.y : b.x;
+                    const int32_t a_perpendicular = (by_y==1) ? a.x : a.y;
+                    const int32_t b_perpendicular = (by_y==1) ? b.x : b.y;
+                    if(a_main!=b_main) take_left = (a_main<b_main);
+                    else if(a_perpendicular!=b_perpendicular) take_left = (a_perpendicular<b_perpendicular);
+                    else take_left = ((*from)[left]<(*from)[right]);
                 }
-            }
-            else if(this->_events[i].k_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION&&this->_events[i].k_events[j].pressing_down==1)
-            {
-                parts_of_event_to_complete++;
+                if(take_left==1) {(*to)[out] = (*from)[left]; left++;}
+                else {(*to)[out] = (*from)[right]; right++;}
+                out++;
             }
         }
+        CustomVector<uint32_t>* swap = from;
+        from = to;
+        to = swap;
+    }
+    if(from!=&indexes)
+    {
+        for(size_t n = 0; n<count; n++) indexes[n] = buffer[n];
+    }
+    return;
+}
+
+int64_t cSDL_ButtonsManager::_find_button_in_direction(TypeOfFocusInteraction interaction,uint32_t max_perpendicular_difference)
+{
+    bool vertical,negative,nearest;
+    switch(interaction)
+    {
+        case TypeOfFocusInteraction::NEAREST_LEFT: vertical = 0; negative = 1; nearest = 1; break;
+        case TypeOfFocusInteraction::NEAREST_RIGHT: vertical = 0; negative = 0; nearest = 1; break;
+        case TypeOfFocusInteraction::NEAREST_UP: vertical = 1; negative = 1; nearest = 1; break;
+        case TypeOfFocusInteraction::NEAREST_DOWN: vertical = 1; negative = 0; nearest = 1; break;
+        case TypeOfFocusInteraction::FAR_LEFT: vertical = 0; negative = 1; nearest = 0; break;
+        case TypeOfFocusInteraction::FAR_RIGHT: vertical = 0; negative = 0; nearest = 0; break;
+        case TypeOfFocusInteraction::FAR_UP: vertical = 1; negative = 1; nearest = 0; break;
+        case TypeOfFocusInteraction::FAR_DOWN: vertical = 1; negative = 0; nearest = 0; break;
+        default: return -1;
+    }
 
-        for(size_t j = 0; j<m_size; j++)
+    if(this->_navigation_index_needs_rebuild==1) this->_rebuild_navigation_index();
+    if(this->_navigation_count_of_buttons_without_width!=0) return this->_find_button_in_direction_linear(vertical,negative,nearest,max_perpendicular_difference);
+
+    // "main" is axis of direction and "perpendicular" is the second one; buttons are searched by main position in range of perpendicular position;
+    const size_t count_of_buttons = this->_buttons.size();
+    const CustomVector<uint32_t>& sorted_by_main = (vertical==1) ? this->_navigation_sorted_by_y : this->_navigation_sorted_by_x;
+    const CustomVector<uint32_t>& sorted_by_perpendicular = (vertical==1) ? this->_navigation_sorted_by_x : this->_navigation_sorted_by_y;
+    const CustomVector<int32_t>& levels = (vertical==1) ? this->_navigation_y_levels : this->_navigation_x_levels;
+    const SDL_Rect& focused = this->_buttons[this->_actual_button_index_focus].button_dimensions;
+    const int32_t focused_main = (vertical==1) ? focused.y : focused.x;
+    const int32_t focused_perpendicular = (vertical==1) ? focused.x : focused.y;
+    const int64_t perpendicular_min = (int64_t)focused_perpendicular-max_perpendicular_difference;
+    const int64_t perpendicular_max = (int64_t)focused_perpendicular+max_perpendicular_difference;
+
+    // range of buttons in "sorted_by_perpendicular" that are in perpendicular range;
+    size_t first = 0,last = count_of_buttons;
+    for(int32_t bound = 0; bound<2; bound++)
+    {
+        size_t low = 0,high = count_of_buttons;
+        while(low<high)
+        {
+            const size_t middle = (low+high)/2;
+            const SDL_Rect& dimensions = this->_buttons[sorted_by_perpendicular[middle]].button_dimensions;
+            const int64_t perpendicular = (vertical==1) ? dimensions.x : dimensions.y;
+            if((bound==0) ? (perpendicular<perpendicular_min) : (perpendicular<=perpendicular_max)) low = middle+1;
+            else high = middle;
+        }
+        if(bound==0) first = low;
+        else last = low;
+    }
+    if(first>=last) return -1;
+
+    // the best main position: NEAREST_* looks for the closest one before/after focused button; FAR_* looks for the furthest one;
+    //      range is splitted for aligned blocks that are sorted in some level of "levels";
+    bool found = 0;
+    int32_t best_main = 0;
+    size_t position = first;
+    while(position<last)
+    {
+        size_t level = 0;
+        while(level+1<this->_navigation_levels_count&&(position&(((size_t)2<<level)-1))==0&&position+((size_t)2<<level)<=last) level++;
+        const size_t block_size = (size_t)1<<level;
+        const size_t block = level*count_of_buttons+position;
+        position+=block_size;
+
+        int32_t value;
+        if(nearest==1)
         {
-            if(event->button.button==this->_events[i].m_events[j].mouse_key)
+            // the last value lower than focused one or the first value greater than focused one;
+            size_t low = 0,high = block_size;
+            while(low<high)
             {
-                if(event->type==SDL_MOUSEBUTTONDOWN)
-                {
-                    if(this->_events[i].m_events[j].type==TypeOfPress::DOWN||this->_events[i].m_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION)
-                    {
-                        // set that this part of event is completed;
-                        parts_of_event_to_complete++;
-                    }
-
-                    this->_events[i].m_events[j].last_pressed_focused_button_id = this->_actual_button_id_focus; // important only if u choose "DOWN_UP" of "this->_events[i].m_events[j].type"
-                    this->_events[i].m_events[j].pressing_down = 1;
-                }
-                else if(event->type==SDL_MOUSEBUTTONUP)
-                {
-                    if(this->_events[i].m_events[j].type==TypeOfPress::UP)
-                    {
-                        // set that this part of event is completed;
-                        parts_of_event_to_complete++;
-                    }
-                    else if(this->_events[i].m_events[j].type==TypeOfPress::DOWN_UP)
-                    {
-                        if(this->_events[i].m_events[j].pressing_down==1&&this->_events[i].m_events[j].last_pressed_focused_button_id==this->_actual_button_id_focus)
-                        {
-                            // set that this part of event is completed;
-                            parts_of_event_to_complete++;
-                        }
-                        this->_events[i].m_events[j].last_pressed_focused_button_id = 0;    // important only if u choose "DOWN_UP" of "this->_events[i].m_events[j].type"
-                    }
-                    this->_events[i].m_events[j].pressing_down = 0;
-                }
+                const size_t middle = (low+high)/2;
+                if((negative==1) ? (levels[block+middle]<focused_main) : (levels[block+middle]<=focused_main)) low = middle+1;
+                else high = middle;
             }
-            else if(this->_events[i].m_events[j].type==TypeOfPress::HOLD_DOWN_COMBINATION&&this->_events[i].m_events[j].pressing_down==1)
+            if(negative==1)
             {
-                parts_of_event_to_complete++;
+                if(low==0) continue;
+                value = levels[block+low-1];
+            }
+            else
+            {
+                if(low==block_size) continue;
+                value = levels[block+low];
             }
         }
+        else value = (negative==1) ? levels[block] : levels[block+block_size-1];
 
-        for(size_t j = 0; j<s_size; j++)
+        if(found==0||((negative==nearest) ? (value>best_main) : (value<best_main))) best_main = value;
+        found = 1;
+    }
+    if(found==0) return -1;
+    if((negative==1) ? (best_main>=focused_main) : (best_main<=focused_main)) return -1;
+
+    // buttons with "best_main" position are next to each other in "sorted_by_main" and sorted by perpendicular position;
+    //      the best one has the lowest perpendicular difference and then the lowest index;
+    //      checked are the first button at or after focused perpendicular position and the first one of the previous position;
+    size_t low = 0,high = count_of_buttons;
+    int64_t search_perpendicular = focused_perpendicular;
+    int64_t nearest_button_index = -1;
+    int64_t nearest_difference = 0;
+    for(int32_t side = 0; side<2; side++)
+    {
+        low = 0; high = count_of_buttons;
+        while(low<high)
         {
-            if(event->type==this->_events[i].s_events[j].type)
-            {
-                // set that this part of event is complete;
-                parts_of_event_to_complete++;
-            }
+            const size_t middle = (low+high)/2;
+            const SDL_Rect& dimensions = this->_buttons[sorted_by_main[middle]].button_dimensions;
+            const int32_t button_main = (vertical==1) ? dimensions.y : dimensions.x;
+            const int64_t perpendicular = (vertical==1) ? dimensions.x : dimensions.y;
+            if(button_main<best_main||(button_main==best_main&&perpendicular<search_perpendicular)) low = middle+1;
+            else high = middle;
         }
 
-        if(parts_of_event_to_complete==(k_size+m_size+s_size))      // if user defined function should be executed and check if u should make here "auto focus changing" mechanism;
+        if(side==0)
         {
-            if(this->_events[i].default_button_focus_id!=0&&this->_actual_button_id_focus==0)   // if default button option is ON;
+            if(low<count_of_buttons)
             {
-                bool id_doesnt_exists = 1;
-                size_t count_of_buttons = this->_buttons.size();
-                for(size_t j = 0; j<count_of_buttons; j++)
-                {
-                    if(this->_buttons[j].id==this->_events[i].default_button_focus_id)
-                    {
-                        this->_actual_button_id_focus = this->_buttons[j].id;
-                        this->_actual_button_index_focus = j;
-                        id_doesnt_exists = 0;
-                        break;
-                    }
-                }
-                if(id_doesnt_exists==1)
+                const SDL_Rect& dimensions = this->_buttons[sorted_by_main[low]].button_dimensions;
+                const int32_t button_main = (vertical==1) ? dimensions.y : dimensions.x;
+                const int64_t perpendicular = (vertical==1) ? dimensions.x : dimensions.y;
+                if(button_main==best_main&&perpendicular<=perpendicular_max)
                 {
-                    if(count_of_buttons!=0)
-                    {
-                        this->_actual_button_id_focus = this->_buttons[0].id;
-                        this->_actual_button_index_focus = 0;
-                    }
-                    else
-                    {
-                        this->_actual_button_id_focus = 0;
-                        this->_actual_button_index_focus = 0xFFFFFFFF;
-                    }
+                    nearest_button_index = sorted_by_main[low];
+                    nearest_difference = perpendicular-focused_perpendicular;
                 }
             }
-            else if(this->_events[i].focus_interaction_area.w!=-1&&this->_actual_button_index_focus!=0xFFFFFFFF)  // if "auto focus changing" mechanism is ON;
+            if(low==0) break;
+            const SDL_Rect& dimensions = this->_buttons[sorted_by_main[low-1]].button_dimensions;
+            const int32_t button_main = (vertical==1) ? dimensions.y : dimensions.x;
+            const int64_t perpendicular = (vertical==1) ? dimensions.x : dimensions.y;
+            if(button_main!=best_main||perpendicular<perpendicular_min) break;
+            search_perpendicular = perpendicular;   // the next search finds the first button of this position;
+        }
+        else
+        {
+            const int64_t difference = focused_perpendicular-search_perpendicular;
+            if(nearest_button_index==-1||difference<nearest_difference||(difference==nearest_difference&&sorted_by_main[low]<nearest_button_index))
             {
-                SDL_Rect area_searching = this->_events[i].focus_interaction_area;
-                if(this->_do_buttons_scals_with_window_w_h==1)
-                {
-                    area_searching.x*=this->_scale_button_dimensions_x;
-                    area_searching.w*=this->_scale_button_dimensions_x;
-                    area_searching.y*=this->_scale_button_dimensions_y;
-                    area_searching.h*=this->_scale_button_dimensions_y;
-                }
-
-                TypeOfFocusInteraction interaction = this->_events[i].main_focus_interaction;
-                size_t count_of_buttons = this->_buttons.size();
-                int64_t nearest_button_index = -1;
-                SDL_Rect nearest_dimensions;
-                nearest_dimensions.w = -1;
-                uint32_t max_perpendicular_difference = this->_events[i].max_perpendicular_difference;
-                for(int32_t iteration = 0; iteration<2; iteration++)
-                {
-
-                    switch(interaction)
-                    {
-                        case TypeOfFocusInteraction::NEAREST_LEFT:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y);
-                                    const int32_t new_x = this->_buttons[j].button_dimensions.x;
-
-                                    if((new_x<this->_buttons[this->_actual_button_index_focus].button_dimensions.x)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x>nearest_dimensions.x)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x==nearest_dimensions.x&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-
-                        }break;
-
-                        case TypeOfFocusInteraction::NEAREST_RIGHT:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y);
-                                    const int32_t new_x = this->_buttons[j].button_dimensions.x;
-
-                                    if((new_x>this->_buttons[this->_actual_button_index_focus].button_dimensions.x)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x<nearest_dimensions.x)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x==nearest_dimensions.x&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
-
-                        case TypeOfFocusInteraction::NEAREST_UP:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x);
-                                    const int32_t new_y = this->_buttons[j].button_dimensions.y;
-
-                                    if((new_y<this->_buttons[this->_actual_button_index_focus].button_dimensions.y)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y>nearest_dimensions.y)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y==nearest_dimensions.y&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
-
-                        case TypeOfFocusInteraction::NEAREST_DOWN:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x);
-                                    const int32_t new_y = this->_buttons[j].button_dimensions.y;
-
-                                    if((new_y>this->_buttons[this->_actual_button_index_focus].button_dimensions.y)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y<nearest_dimensions.y)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y==nearest_dimensions.y&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
-
-                        case TypeOfFocusInteraction::FAR_LEFT:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y);
-                                    const int32_t new_x = this->_buttons[j].button_dimensions.x;
-
-                                    if((new_x<this->_buttons[this->_actual_button_index_focus].button_dimensions.x)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x<nearest_dimensions.x)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x==nearest_dimensions.x&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
-
-                        case TypeOfFocusInteraction::FAR_RIGHT:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y);
-                                    const int32_t new_x = this->_buttons[j].button_dimensions.x;
-
-                                    if((new_x>this->_buttons[this->_actual_button_index_focus].button_dimensions.x)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x>nearest_dimensions.x)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_x==nearest_dimensions.x&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.y-this->_buttons[this->_actual_button_index_focus].button_dimensions.y))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
-
-                        case TypeOfFocusInteraction::FAR_UP:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x);
-                                    const int32_t new_y = this->_buttons[j].button_dimensions.y;
+                nearest_button_index = sorted_by_main[low];
+            }
+        }
+    }
 
-                                    if((new_y<this->_buttons[this->_actual_button_index_focus].button_dimensions.y)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y<nearest_dimensions.y)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y==nearest_dimensions.y&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
+    return nearest_button_index;
+}
 
-                        case TypeOfFocusInteraction::FAR_DOWN:
-                        {
-                            for(size_t j = 0; j<count_of_buttons; j++)
-                            {
-                                if(this->_actual_button_index_focus!=j)
-                                {
-                                    const uint32_t abs_perpendicular_difference = abs(this->_buttons[j].button_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x);
-                                    const int32_t new_y = this->_buttons[j].button_dimensions.y;
+int64_t cSDL_ButtonsManager::_find_button_in_direction_linear(bool vertical,bool negative,bool nearest,uint32_t max_perpendicular_difference) const
+{
+    const size_t count_of_buttons = this->_buttons.size();
+    const SDL_Rect& focused = this->_buttons[this->_actual_button_index_focus].button_dimensions;
+    const int32_t focused_main = (vertical==1) ? focused.y : focused.x;
+    const int32_t focused_perpendicular = (vertical==1) ? focused.x : focused.y;
+    int64_t nearest_button_index = -1;
+    SDL_Rect nearest_dimensions = {0,0,-1,0};
 
-                                    if((new_y>this->_buttons[this->_actual_button_index_focus].button_dimensions.y)
-                                       &&(abs_perpendicular_difference<=max_perpendicular_difference))
-                                    {
-                                        if(nearest_dimensions.w==-1)    // first button checking;
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y>nearest_dimensions.y)
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                        else if(new_y==nearest_dimensions.y&&abs_perpendicular_difference<(uint32_t)abs(nearest_dimensions.x-this->_buttons[this->_actual_button_index_focus].button_dimensions.x))
-                                        {
-                                            nearest_dimensions = this->_buttons[j].button_dimensions;
-                                            nearest_button_index = j;
-                                        }
-                                    }
-                                }
-                            }
-                        }break;
+    for(size_t j = 0; j<count_of_buttons; j++)
+    {
+        if(this->_actual_button_index_focus!=j)
+        {
+            const SDL_Rect& dimensions = this->_buttons[j].button_dimensions;
+            const uint32_t abs_perpendicular_difference = abs(((vertical==1) ? dimensions.x : dimensions.y)-focused_perpendicular);
+            const int32_t new_main = (vertical==1) ? dimensions.y : dimensions.x;
 
-                    }
-                    if(iteration==0&&nearest_button_index==-1)
-                    {
-                        interaction = this->_events[i].addtional_focus_interaction;
-                        max_perpendicular_difference = this->_events[i].max_perpendicular_difference_additional;
-                        continue;
-                    }
-                    else break;
+            if(((negative==1) ? (new_main<focused_main) : (new_main>focused_main))
+               &&(abs_perpendicular_difference<=max_perpendicular_difference))
+            {
+                const int32_t nearest_main = (vertical==1) ? nearest_dimensions.y : nearest_dimensions.x;
+                const int32_t nearest_perpendicular = (vertical==1) ? nearest_dimensions.x : nearest_dimensions.y;
+                if(nearest_dimensions.w==-1)    // first button checking;
+                {
+                    nearest_dimensions = dimensions;
+                    nearest_button_index = j;
                 }
-
-                if(nearest_button_index!=-1)
+                else if((negative==nearest) ? (new_main>nearest_main) : (new_main<nearest_main))
                 {
-                    this->_actual_button_index_focus = nearest_button_index;
-                    this->_actual_button_id_focus = this->_buttons[nearest_button_index].id;
+                    nearest_dimensions = dimensions;
+                    nearest_button_index = j;
+                }
+                else if(new_main==nearest_main&&abs_perpendicular_difference<(uint32_t)abs(nearest_perpendicular-focused_perpendicular))
+                {
+                    nearest_dimensions = dimensions;
+                    nearest_button_index = j;
                 }
-
             }
-
-            this->_events[i].activated_func(this->_events[i].user_data,event,this);
-            break;
         }
     }
-
-    return;
+    return nearest_button_index;
 }
 
 CustomVector<cSDL_ButtonsManager::Event>& cSDL_ButtonsManager::get_event_vector()
 {
+    this->_invalidate_events_caches();  // vector can be changed by user so every cache is rebuilt at its next use;
     return this->_events;
 }
 
 CustomVector<cSDL_ButtonsManager::Button>& cSDL_ButtonsManager::get_button_vector()
 {
+    this->_invalidate_buttons_caches();
     return this->_buttons;
 }
 
@@ -3549,7 +5167,7 @@ public:
 
 private:
     CustomVector<SDL_Rect> _positions;  // remember to check if this variable size() isn't 0;
-    CustomVector<MouseValues> _interactive_slider_buttons;  // by default there's only "MOUSE_BUTTON_LEFT"; remember to check if this variable size() isn't 0;
+    SmallCustomVector<MouseValues,4> _interactive_slider_buttons;  // by default there's only "MOUSE_BUTTON_LEFT"; remember to check if this variable size() isn't 0;
     bool _slider_focus; // does slider has mouse focsu;
     bool _slider_held;  // does slider keep track of the mouse/is moving by the mouse;
     uint32_t _actual_slider_position_index;    // index of "_positions" that is active right now;
@@ -3967,7 +5585,7 @@ public:
 
 private:
     struct MousePoint {int32_t x; int32_t y;};
-    CustomVector<MouseValues> _interactive_buttons;  // by default there's only "MOUSE_BUTTON_LEFT"; remember to check if this variable size() isn't 0;
+    SmallCustomVector<MouseValues,4> _interactive_buttons;  // by default there's only "MOUSE_BUTTON_LEFT"; remember to check if this variable size() isn't 0;
     CustomVector<int32_t> _slider_segments;
     int32_t _slider_start_x;
     int32_t _slider_start_y;
@@ -4146,7 +5764,7 @@ uint32_t cSDL_AutomaticSlider::get_slider_actual_segment() const
     return this->_actual_slider_segment;
 }
 
-uint32_t cSDL_AutomaticSlider::get_slider_count_of_segments() const
+size_t cSDL_AutomaticSlider::get_slider_count_of_segments() const
 {
     return this->_slider_segments_count;
 }
@@ -4490,33 +6108,32 @@ void cSDL_AutomaticSlider::run_checker(SDL_Event* event)
 
 void cSDL_AutomaticSlider::_recalculate_slider_segments()
 {
-    this->_slider_segments.clear();
-    this->_slider_segments.reserve(this->_slider_segments_count+1);
+    this->_slider_segments.resize_uninitialized(this->_slider_segments_count+1);   // every element is written below so there's no need to initialize them;
 
     if(this->_slider_type==TypeOfSlider::HORIZONTAL)
     {
         const int32_t slider_right = this->_slider_start_x+this->_slider_width;
-        this->_slider_segments.push_back(slider_right);
+        this->_slider_segments[0] = slider_right;
         double segment_shift_value = (((double)abs(this->_slider_end_x_y-slider_right))/(double)this->_slider_segments_count);
         double actual_segment_value = slider_right+segment_shift_value;
         for(size_t i = 1; i<this->_slider_segments_count; i++)
         {
-            this->_slider_segments.push_back((int32_t)actual_segment_value);
+            this->_slider_segments[i] = (int32_t)actual_segment_value;
             actual_segment_value+=segment_shift_value;
         }
-        this->_slider_segments.push_back(this->_slider_end_x_y);
+        this->_slider_segments[this->_slider_segments_count] = this->_slider_end_x_y;
     }
     else
     {
-        this->_slider_segments.push_back(this->_slider_start_y);
+        this->_slider_segments[0] = this->_slider_start_y;
         double segment_shift_value = (((double)abs(this->_slider_start_y-this->_slider_end_x_y))/(double)this->_slider_segments_count);
         double actual_segment_value = this->_slider_start_y-segment_shift_value;
         for(size_t i = 1; i<this->_slider_segments_count; i++)
         {
-            this->_slider_segments.push_back((int32_t)actual_segment_value);
+            this->_slider_segments[i] = (int32_t)actual_segment_value;
             actual_segment_value-=segment_shift_value;
         }
-        this->_slider_segments.push_back(this->_slider_end_x_y);
+        this->_slider_segments[this->_slider_segments_count] = this->_slider_end_x_y;
     }
 
     /*for(size_t i = 0; i<this->_slider_segments.size(); i++)
@@ -4526,3 +6143,5 @@ void cSDL_AutomaticSlider::_recalculate_slider_segments()
 
     return;
 }
+
+#endif
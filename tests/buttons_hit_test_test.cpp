@@ -0,0 +1,160 @@
+// randomized test of mouse hit-test of "cSDL_ButtonsManager" (linear SIMD search and spatial index);
+//      every mouse motion is compared with the oryginal algorithm (scan of every button from the last one) run on a copy of buttons kept by the test;
+//      no window is opened; SDL_MOUSEMOTION events are made by hand and passed to "run_event_checker()";
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/buttons_hit_test_test.cpp -o buttons_hit_test_test `sdl2-config --cflags --libs` -lSDL2_image && ./buttons_hit_test_test
+//      (add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <vector>
+
+struct ModelButton
+{
+    uint32_t id;
+    SDL_Rect dimensions;
+    bool gain_focus_by_mouse_cursor;
+};
+
+struct Model
+{
+    std::vector<ModelButton> buttons;
+    bool scaling;
+    double scale_x; double scale_y;
+};
+
+// the same code as "run_event_checker()" had before any index;
+static uint32_t reference_hit_test(const Model& model,int32_t mouse_x,int32_t mouse_y)
+{
+    for(int64_t i = (int64_t)model.buttons.size()-1; i>=0; i--)
+    {
+        if(model.buttons[i].gain_focus_by_mouse_cursor==1)
+        {
+            SDL_Rect dimensions = model.buttons[i].dimensions;
+            if(model.scaling==1)
+            {
+                dimensions.x*=model.scale_x;
+                dimensions.w*=model.scale_x;
+                dimensions.y*=model.scale_y;
+                dimensions.h*=model.scale_y;
+            }
+            if((mouse_x>=dimensions.x&&mouse_x<=(dimensions.x+dimensions.w))&&(mouse_y>=dimensions.y&&mouse_y<=(dimensions.y+dimensions.h))) return model.buttons[i].id;
+        }
+    }
+    return 0;
+}
+
+static SDL_Rect random_rect()
+{
+    SDL_Rect rect;
+    const int32_t kind = rand()%10;
+    rect.x = rand()%1000-50; rect.y = rand()%800-50;
+    if(kind==0) {rect.w = 500+rand()%1500; rect.h = 400+rand()%1000;}     // covers many cells;
+    else if(kind==1) {rect.w = rand()%10-5; rect.h = rand()%10-5;}        // empty or negative;
+    else {rect.w = rand()%120; rect.h = rand()%120;}
+    return rect;
+}
+
+static int32_t run_seed(uint32_t seed)
+{
+    srand(seed);
+    cSDL_ButtonsManager manager;
+    Model model;
+    model.scaling = 0; model.scale_x = 1.0; model.scale_y = 1.0;
+
+    const bool spatial_index = (rand()%3!=0);
+    if(spatial_index==1) manager.enable_spatial_index(1,rand()%200);
+    if(rand()%2==0)
+    {
+        const uint32_t new_w = 600+rand()%1400,new_h = 400+rand()%1000;
+        manager.enable_scaling_mechanism(1);
+        manager.update_scaling_mechanism(1280,720,new_w,new_h);
+        model.scaling = 1;
+        model.scale_x = (double)((double)new_w/(double)1280);
+        model.scale_y = (double)((double)new_h/(double)720);
+    }
+
+    const int32_t count_of_buttons = rand()%400;
+    for(int32_t i = 0; i<count_of_buttons; i++)
+    {
+        ModelButton button;
+        button.dimensions = random_rect();
+        button.gain_focus_by_mouse_cursor = (rand()%5!=0);
+        button.id = manager.create_button(button.dimensions,button.gain_focus_by_mouse_cursor,i);
+        model.buttons.push_back(button);
+    }
+
+    SDL_Event event;
+    memset(&event,0,sizeof(event));
+    event.type = SDL_MOUSEMOTION;
+    for(int32_t q = 0; q<3000; q++)
+    {
+        const int32_t operation = rand()%100;
+        if(operation==0&&model.buttons.size()!=0)     // delete by id (deferred);
+        {
+            const size_t i = rand()%model.buttons.size();
+            manager.delete_buttons(model.buttons[i].id);
+            model.buttons.erase(model.buttons.begin()+i);
+        }
+        else if(operation==1&&model.buttons.size()!=0)    // delete range of indexes;
+        {
+            const size_t from = rand()%model.buttons.size();
+            const size_t to = from+rand()%5;
+            manager.delete_buttons((uint32_t)from,(uint32_t)to);
+            model.buttons.erase(model.buttons.begin()+from,model.buttons.begin()+((to<model.buttons.size()) ? to+1 : model.buttons.size()));
+        }
+        else if(operation<5&&model.buttons.size()!=0)     // change dimensions/attribute;
+        {
+            const size_t i = rand()%model.buttons.size();
+            if(operation==2) {model.buttons[i].dimensions = random_rect(); manager.change_button_dimensions(model.buttons[i].id,model.buttons[i].dimensions);}
+            else {model.buttons[i].gain_focus_by_mouse_cursor = rand()%2; manager.change_button_attribute_to_gain_focus_by_cursor(model.buttons[i].id,model.buttons[i].gain_focus_by_mouse_cursor);}
+        }
+        else if(operation==5)   // new button;
+        {
+            ModelButton button;
+            button.dimensions = random_rect();
+            button.gain_focus_by_mouse_cursor = 1;
+            button.id = manager.create_button(button.dimensions,1,0);
+            model.buttons.push_back(button);
+        }
+        else if(operation==6&&model.buttons.size()>1)     // manual change through "get_button_vector()" without forcing update of caches;
+        {
+            CustomVector<cSDL_ButtonsManager::Button>& buttons = manager.get_button_vector();
+            const size_t a = rand()%buttons.size(),b = rand()%buttons.size();
+            cSDL_ButtonsManager::Button swap = buttons[a]; buttons[a] = buttons[b]; buttons[b] = swap;
+            ModelButton model_swap = model.buttons[a]; model.buttons[a] = model.buttons[b]; model.buttons[b] = model_swap;
+            buttons[a].button_dimensions = random_rect();
+            model.buttons[a].dimensions = buttons[a].button_dimensions;
+        }
+
+        event.motion.x = rand()%2200-100;
+        event.motion.y = rand()%1600-100;
+        manager.set_manually_focus_device(cSDL_ButtonsManager::MOUSE);
+        manager.run_event_checker(&event);
+        const uint32_t expected = reference_hit_test(model,event.motion.x,event.motion.y);
+        if(manager.get_focused_button_id()!=expected)
+        {
+            printf("seed %u step %d: focused button %u, expected %u\n",seed,q,manager.get_focused_button_id(),expected);
+            return -1;
+        }
+        if(expected!=0&&model.buttons[manager.get_focused_button_index()].id!=expected)
+        {
+            printf("seed %u step %d: wrong index of focused button\n",seed,q);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    for(uint32_t seed = 1; seed<=200; seed++)
+    {
+        if(run_seed(seed)!=0) return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
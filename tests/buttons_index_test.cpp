@@ -0,0 +1,124 @@
+// randomized test of ids and indexes of buttons/events of "cSDL_ButtonsManager" while some of them are deleted by id and not removed yet;
+//      "get_button_index()","get_event_index()","get_focused_button_index()" and counts are compared with vectors of ids kept by the test;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/buttons_index_test.cpp -o buttons_index_test `sdl2-config --cflags --libs` -lSDL2_image && ./buttons_index_test
+//      (add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <vector>
+
+static void empty_callback(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj)
+{
+    (void)user_data; (void)event; (void)class_obj;
+    return;
+}
+
+static size_t find_in_model(const std::vector<uint32_t>& ids,uint32_t id)
+{
+    for(size_t i = 0; i<ids.size(); i++) if(ids[i]==id) return i;
+    return 0xFFFFFFFF;
+}
+
+static int32_t run_seed(uint32_t seed)
+{
+    srand(seed);
+    cSDL_ButtonsManager manager;
+    std::vector<uint32_t> buttons;
+    std::vector<uint32_t> events;
+    uint32_t last_button_id = 0,last_event_id = 0;
+
+    for(int32_t q = 0; q<4000; q++)
+    {
+        const int32_t operation = rand()%12;
+        if(operation<3)
+        {
+            SDL_Rect rect = {rand()%500,rand()%500,20,20};
+            last_button_id = manager.create_button(rect,1,0);
+            buttons.push_back(last_button_id);
+        }
+        else if(operation<5)
+        {
+            last_event_id = manager.create_event(empty_callback,NULL);
+            events.push_back(last_event_id);
+        }
+        else if(operation<8&&buttons.size()!=0)     // delete by id (marked and removed later);
+        {
+            const size_t i = rand()%buttons.size();
+            manager.delete_buttons(buttons[i]);
+            buttons.erase(buttons.begin()+i);
+        }
+        else if(operation<10&&events.size()!=0)
+        {
+            const size_t i = rand()%events.size();
+            manager.delete_events(events[i]);
+            events.erase(events.begin()+i);
+        }
+        else if(operation==10&&buttons.size()!=0)
+        {
+            manager.set_manually_button_focus(buttons[rand()%buttons.size()]);
+        }
+        else if(operation==11)  // functions that remove marked elements;
+        {
+            const int32_t kind = rand()%4;
+            if(kind==0&&buttons.size()!=0)
+            {
+                const size_t from = rand()%buttons.size();
+                manager.delete_buttons((uint32_t)from,(uint32_t)from);
+                buttons.erase(buttons.begin()+from);
+            }
+            else if(kind==1&&events.size()!=0)
+            {
+                const size_t from = rand()%events.size();
+                manager.delete_events((uint32_t)from,(uint32_t)from);
+                events.erase(events.begin()+from);
+            }
+            else if(kind==2) manager.get_button_vector();
+            else manager.get_event_vector();
+        }
+
+        // every check goes through const object like user code that only reads state;
+        const cSDL_ButtonsManager& reader = manager;
+        if(reader.get_count_of_buttons()!=buttons.size()||reader.get_count_of_events()!=events.size())
+        {
+            printf("seed %u step %d: wrong count\n",seed,q);
+            return -1;
+        }
+        for(int32_t check = 0; check<4; check++)
+        {
+            const uint32_t button_id = (rand()%4==0) ? last_button_id : 1+rand()%(last_button_id+1);
+            if(reader.get_button_index(button_id)!=find_in_model(buttons,button_id))
+            {
+                printf("seed %u step %d: index of button %u is %zu, expected %zu\n",seed,q,button_id,reader.get_button_index(button_id),find_in_model(buttons,button_id));
+                return -1;
+            }
+            const uint32_t event_id = (rand()%4==0) ? last_event_id : 1+rand()%(last_event_id+1);
+            if(reader.get_event_index(event_id)!=find_in_model(events,event_id))
+            {
+                printf("seed %u step %d: index of event %u is %zu, expected %zu\n",seed,q,event_id,reader.get_event_index(event_id),find_in_model(events,event_id));
+                return -1;
+            }
+        }
+        const uint32_t focused_id = reader.get_focused_button_id();
+        const size_t expected_focus = (focused_id==0) ? 0xFFFFFFFF : find_in_model(buttons,focused_id);
+        if(reader.get_focused_button_index()!=expected_focus)
+        {
+            printf("seed %u step %d: index of focused button is %zu, expected %zu\n",seed,q,reader.get_focused_button_index(),expected_focus);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    for(uint32_t seed = 1; seed<=100; seed++)
+    {
+        if(run_seed(seed)!=0) return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
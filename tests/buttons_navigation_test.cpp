@@ -0,0 +1,224 @@
+// randomized test of "auto focus changing" mechanism (NEAREST_*/FAR_*) of "cSDL_ButtonsManager" answered by navigation index;
+//      after every key press the focused button is compared with the result of the oryginal eight linear scans run on a copy of buttons kept by the test;
+//      layouts are made on small grids so there are many buttons with equal x/y (ties are the hardest part of the index) and some buttons have w==-1;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/buttons_navigation_test.cpp -o buttons_navigation_test `sdl2-config --cflags --libs` -lSDL2_image && ./buttons_navigation_test
+//      (add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+typedef cSDL_ButtonsManager::TypeOfFocusInteraction Interaction;
+
+struct ModelButton
+{
+    uint32_t id;
+    SDL_Rect dimensions;
+};
+
+struct ModelEvent
+{
+    SDL_Keycode key;
+    Interaction main_interaction;
+    Interaction additional_interaction;
+    uint32_t max_perpendicular_difference;
+    uint32_t max_perpendicular_difference_additional;
+};
+
+// one of eight scans of the oryginal code; "vertical" is 1 for UP/DOWN, "negative" is 1 for LEFT/UP and "nearest" is 1 for NEAREST_*;
+//      "nearest_dimensions.w==-1" means that nothing is chosen yet exactly like in the oryginal code (so button with w==-1 can be replaced by any next one);
+static int64_t reference_scan(const std::vector<ModelButton>& buttons,size_t focus,bool vertical,bool negative,bool nearest,uint32_t max_perpendicular_difference,SDL_Rect& nearest_dimensions)
+{
+    int64_t nearest_button_index = -1;
+    const SDL_Rect focused = buttons[focus].dimensions;
+    for(size_t j = 0; j<buttons.size(); j++)
+    {
+        if(j==focus) continue;
+        const SDL_Rect dimensions = buttons[j].dimensions;
+        const uint32_t abs_perpendicular_difference = (vertical==1) ? abs(dimensions.x-focused.x) : abs(dimensions.y-focused.y);
+        const int32_t new_main = (vertical==1) ? dimensions.y : dimensions.x;
+        const int32_t focused_main = (vertical==1) ? focused.y : focused.x;
+        const bool in_direction = (negative==1) ? (new_main<focused_main) : (new_main>focused_main);
+        if(in_direction==0||abs_perpendicular_difference>max_perpendicular_difference) continue;
+
+        const int32_t nearest_main = (vertical==1) ? nearest_dimensions.y : nearest_dimensions.x;
+        const uint32_t nearest_perpendicular = (vertical==1) ? (uint32_t)abs(nearest_dimensions.x-focused.x) : (uint32_t)abs(nearest_dimensions.y-focused.y);
+        // nearest to the left/up is the one with the biggest coordinate; the farthest one has the smallest; and the opposite to the right/down;
+        const bool better_main = (negative==nearest) ? (new_main>nearest_main) : (new_main<nearest_main);
+        if(nearest_dimensions.w==-1||better_main==1||(new_main==nearest_main&&abs_perpendicular_difference<nearest_perpendicular))
+        {
+            nearest_dimensions = dimensions;
+            nearest_button_index = j;
+        }
+    }
+    return nearest_button_index;
+}
+
+static int64_t reference_navigation(const std::vector<ModelButton>& buttons,size_t focus,const ModelEvent& event)
+{
+    SDL_Rect nearest_dimensions;
+    nearest_dimensions.x = 0; nearest_dimensions.y = 0; nearest_dimensions.h = 0;
+    nearest_dimensions.w = -1;
+    Interaction interaction = event.main_interaction;
+    uint32_t max_perpendicular_difference = event.max_perpendicular_difference;
+    int64_t found = -1;
+    for(int32_t iteration = 0; iteration<2; iteration++)
+    {
+        bool vertical = 0,negative = 0,nearest = 0;
+        switch(interaction)
+        {
+            case cSDL_ButtonsManager::NEAREST_LEFT: vertical = 0; negative = 1; nearest = 1; break;
+            case cSDL_ButtonsManager::NEAREST_RIGHT: vertical = 0; negative = 0; nearest = 1; break;
+            case cSDL_ButtonsManager::NEAREST_UP: vertical = 1; negative = 1; nearest = 1; break;
+            case cSDL_ButtonsManager::NEAREST_DOWN: vertical = 1; negative = 0; nearest = 1; break;
+            case cSDL_ButtonsManager::FAR_LEFT: vertical = 0; negative = 1; nearest = 0; break;
+            case cSDL_ButtonsManager::FAR_RIGHT: vertical = 0; negative = 0; nearest = 0; break;
+            case cSDL_ButtonsManager::FAR_UP: vertical = 1; negative = 1; nearest = 0; break;
+            case cSDL_ButtonsManager::FAR_DOWN: vertical = 1; negative = 0; nearest = 0; break;
+        }
+        found = reference_scan(buttons,focus,vertical,negative,nearest,max_perpendicular_difference,nearest_dimensions);
+        if(iteration==0&&found==-1)
+        {
+            interaction = event.additional_interaction;
+            max_perpendicular_difference = event.max_perpendicular_difference_additional;
+            continue;
+        }
+        else break;
+    }
+    return found;
+}
+
+static void empty_callback(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj)
+{
+    (void)user_data; (void)event; (void)class_obj;
+    return;
+}
+
+static SDL_Rect random_rect(int32_t grid)
+{
+    SDL_Rect rect;
+    rect.x = (rand()%grid)*10+((rand()%4==0) ? rand()%10 : 0);
+    rect.y = (rand()%grid)*10+((rand()%4==0) ? rand()%10 : 0);
+    rect.w = (rand()%20==0) ? -1 : 5+rand()%20;
+    rect.h = 5+rand()%20;
+    return rect;
+}
+
+static uint32_t random_difference()
+{
+    const int32_t kind = rand()%4;
+    if(kind==0) return 0;
+    if(kind==1) return 0xFFFFFFFF;
+    return rand()%(kind==2 ? 30 : 300);
+}
+
+static int32_t run_seed(uint32_t seed)
+{
+    srand(seed);
+    cSDL_ButtonsManager manager;
+    std::vector<ModelButton> buttons;
+    std::vector<ModelEvent> events;
+
+    const int32_t grid = 2+rand()%30;
+    const int32_t count_of_buttons = 1+rand()%((seed%10==0) ? 2000 : 150);
+    for(int32_t i = 0; i<count_of_buttons; i++)
+    {
+        ModelButton button;
+        button.dimensions = random_rect(grid);
+        button.id = manager.create_button(button.dimensions,1,i);
+        buttons.push_back(button);
+    }
+
+    const Interaction interactions[8] = {cSDL_ButtonsManager::NEAREST_LEFT,cSDL_ButtonsManager::NEAREST_RIGHT,cSDL_ButtonsManager::NEAREST_UP,cSDL_ButtonsManager::NEAREST_DOWN,
+                                         cSDL_ButtonsManager::FAR_LEFT,cSDL_ButtonsManager::FAR_RIGHT,cSDL_ButtonsManager::FAR_DOWN,cSDL_ButtonsManager::FAR_UP};
+    for(int32_t i = 0; i<8; i++)
+    {
+        ModelEvent event;
+        event.key = 'a'+i;
+        event.main_interaction = interactions[rand()%8];
+        event.additional_interaction = interactions[rand()%8];
+        event.max_perpendicular_difference = random_difference();
+        event.max_perpendicular_difference_additional = random_difference();
+        events.push_back(event);
+
+        const uint32_t id = manager.create_event(empty_callback,NULL);
+        manager.add_required_key_for_event(id,cSDL_ButtonsManager::DOWN,event.key);
+        SDL_Rect area = {0,0,1000,1000};
+        manager.change_event_auto_focus_mechanism(id,area,event.main_interaction,event.additional_interaction,
+                                                  event.max_perpendicular_difference,event.max_perpendicular_difference_additional,0);
+    }
+
+    SDL_Event sdl_event;
+    for(int32_t q = 0; q<1500; q++)
+    {
+        const int32_t operation = rand()%40;
+        if(operation==0&&buttons.size()>1)
+        {
+            const size_t i = rand()%buttons.size();
+            manager.delete_buttons(buttons[i].id);
+            buttons.erase(buttons.begin()+i);
+        }
+        else if(operation==1)
+        {
+            ModelButton button;
+            button.dimensions = random_rect(grid);
+            button.id = manager.create_button(button.dimensions,1,0);
+            buttons.push_back(button);
+        }
+        else if(operation==2)
+        {
+            const size_t i = rand()%buttons.size();
+            buttons[i].dimensions = random_rect(grid);
+            manager.change_button_dimensions(buttons[i].id,buttons[i].dimensions);
+        }
+        else if(operation==3&&buttons.size()>1)     // manual change through "get_button_vector()" without forcing update of caches;
+        {
+            CustomVector<cSDL_ButtonsManager::Button>& manager_buttons = manager.get_button_vector();
+            const size_t i = rand()%buttons.size(),j = rand()%buttons.size();
+            cSDL_ButtonsManager::Button swap = manager_buttons[i]; manager_buttons[i] = manager_buttons[j]; manager_buttons[j] = swap;
+            ModelButton model_swap = buttons[i]; buttons[i] = buttons[j]; buttons[j] = model_swap;
+        }
+
+        // focus is moved from random button or it stays where previous key has moved it;
+        size_t focus = 0xFFFFFFFF;
+        for(size_t i = 0; i<buttons.size(); i++) if(buttons[i].id==manager.get_focused_button_id()) focus = i;
+        if(focus==0xFFFFFFFF||rand()%3==0)
+        {
+            focus = rand()%buttons.size();
+            manager.set_manually_button_focus(buttons[focus].id);
+        }
+
+        const size_t e = rand()%events.size();
+        memset(&sdl_event,0,sizeof(sdl_event));
+        sdl_event.type = SDL_KEYDOWN;
+        sdl_event.key.keysym.sym = events[e].key;
+        manager.run_event_checker(&sdl_event);
+        sdl_event.type = SDL_KEYUP;
+        manager.run_event_checker(&sdl_event);
+
+        const int64_t expected = reference_navigation(buttons,focus,events[e]);
+        const uint32_t expected_id = (expected==-1) ? buttons[focus].id : buttons[expected].id;
+        if(manager.get_focused_button_id()!=expected_id)
+        {
+            printf("seed %u step %d: interaction %d/%d from button %u: focused %u, expected %u\n",seed,q,(int32_t)events[e].main_interaction,
+                   (int32_t)events[e].additional_interaction,buttons[focus].id,manager.get_focused_button_id(),expected_id);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    for(uint32_t seed = 1; seed<=300; seed++)
+    {
+        if(run_seed(seed)!=0) return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
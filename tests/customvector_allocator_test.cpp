@@ -0,0 +1,221 @@
+// test of allocators of CustomVector ("CustomBumpArena","CustomVectorAllocatorScope") and containers built on CustomVector;
+//      containers that already exist have to keep their allocator when they grow or are rebuilt inside of scope of other allocator
+//      (otherwise heap container would keep memory of arena after its reset); allocator made for the test counts memory that isn't given back;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/customvector_allocator_test.cpp -o customvector_allocator_test `sdl2-config --cflags --libs` -lSDL2_image && ./customvector_allocator_test
+//      (add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+class CountingAllocator : public CustomVectorAllocator
+{
+public:
+    int64_t live_allocations;
+
+    CountingAllocator()
+    {
+        this->live_allocations = 0;
+        return;
+    }
+
+    void* allocate(size_t bytes,size_t alignment) override
+    {
+        (void)alignment;
+        this->live_allocations++;
+        return malloc(bytes);
+    }
+
+    void deallocate(void* data,size_t bytes) noexcept override
+    {
+        (void)bytes;
+        this->live_allocations--;
+        free(data);
+        return;
+    }
+};
+
+#define CHECK(condition) do {if(!(condition)) {printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition); return -1;}} while(0)
+
+// aligned position can be past the end of the block; it must take the next block instead of overflowing;
+static int32_t test_arena_alignment()
+{
+    CustomBumpArena arena(1000);
+    unsigned char* first = (unsigned char*)arena.allocate(996,4);
+    memset(first,1,996);
+    unsigned char* second = (unsigned char*)arena.allocate(64,16);
+    CHECK(((uintptr_t)second&15)==0);
+    CHECK(second+64<=first||second>=first+996);
+    memset(second,2,64);
+    for(size_t i = 0; i<996; i++) CHECK(first[i]==1);
+
+    // random sizes and alignments; every allocation is filled with its own byte and checked at the end so overlapping can't be missed;
+    srand(1);
+    for(int32_t round = 0; round<20; round++)
+    {
+        std::vector<unsigned char*> pointers;
+        std::vector<size_t> sizes;
+        for(int32_t i = 0; i<2000; i++)
+        {
+            const size_t alignment = (size_t)1<<(rand()%7);
+            const size_t bytes = (rand()%8==0) ? 0 : 1+rand()%((rand()%10==0) ? 3000 : 100);
+            unsigned char* data = (unsigned char*)arena.allocate(bytes,alignment);
+            CHECK(((uintptr_t)data&(alignment-1))==0);
+            memset(data,(int32_t)(i&0xFF),bytes);
+            pointers.push_back(data);
+            sizes.push_back(bytes);
+        }
+        for(size_t i = 0; i<pointers.size(); i++)
+        {
+            for(size_t j = 0; j<sizes[i]; j++) CHECK(pointers[i][j]==(unsigned char)(i&0xFF));
+        }
+        arena.reset();
+    }
+    return 0;
+}
+
+// map and vector made on heap grow (and are cleared) inside of scope of other allocator;
+static int32_t test_heap_containers_in_scope()
+{
+    CustomIdMap map;
+    CustomVector<uint32_t> vector;
+    CountingAllocator allocator;
+    {
+        CustomVectorAllocatorScope scope(&allocator);
+        for(uint32_t i = 0; i<5000; i++) {map.insert(i,i*2); vector.push_back(i);}     // many rehashes and growths;
+        map.clear();
+        for(uint32_t i = 0; i<100; i++) map.insert(i,i*3);
+    }
+    CHECK(allocator.live_allocations==0);
+    CHECK(vector.get_allocator()==NULL);
+    for(uint32_t i = 0; i<100; i++) CHECK(map.find(i)==i*3);
+    CHECK(map.find(100)==0xFFFFFFFF);
+
+    // the same with arena which is destroyed before the map is used again (heap-use-after-free if map took memory of arena);
+    CustomIdMap map_after_arena;
+    {
+        CustomBumpArena arena;
+        CustomVectorAllocatorScope scope(&arena);
+        for(uint32_t i = 0; i<5000; i++) map_after_arena.insert(i,i+1);
+    }
+    for(uint32_t i = 0; i<5000; i++) CHECK(map_after_arena.find(i)==i+1);
+    map_after_arena.clear();
+    CHECK(map_after_arena.size()==0);
+    return 0;
+}
+
+// map made inside of scope keeps its allocator also after the scope (growing outside doesn't move it to heap);
+static int32_t test_scope_containers_outside()
+{
+    CountingAllocator allocator;
+    {
+        CustomIdMap* map;
+        {
+            CustomVectorAllocatorScope scope(&allocator);
+            map = new CustomIdMap();
+        }
+        const int64_t after_construction = allocator.live_allocations;
+        CHECK(after_construction>0);
+        for(uint32_t i = 0; i<5000; i++) map->insert(i,i);
+        map->clear();
+        CHECK(allocator.live_allocations==after_construction);
+        for(uint32_t i = 0; i<5000; i++) map->insert(i,i);
+        CHECK(map->find(4999)==4999);
+        delete map;
+    }
+    CHECK(allocator.live_allocations==0);
+    return 0;
+}
+
+// random operations on vectors in arena compared with std::vector; copies/moves mix vectors of arena and heap (NULL allocator);
+static int32_t test_vectors_in_arena(uint32_t seed)
+{
+    srand(seed);
+    CustomBumpArena arena(4096);
+    for(int32_t round = 0; round<2; round++)
+    {
+        CustomVectorAllocatorScope scope(&arena);
+        {
+            CustomVector<int32_t> vector(4,2),other(4,2);
+            std::vector<int32_t> model,other_model;
+            for(int32_t q = 0; q<100000; q++)
+            {
+                const int32_t operation = rand()%100;
+                const int32_t value = rand();
+                if(operation<50) {vector.push_back(value); model.push_back(value);}
+                else if(operation<60) {other.push_back(value); other_model.push_back(value);}
+                else if(operation<65) {if(model.size()!=0) {vector.pop_back(); model.pop_back();}}
+                else if(operation<67) vector.reserve(rand()%5000);
+                else if(operation<69) vector.shrink_to_fit();
+                else if(operation<70) {vector.clear(); model.clear();}
+                else if(operation<72) {CustomVector<int32_t> copy = vector; vector = copy;}
+                else if(operation<74) {CustomVectorAllocatorScope heap(NULL); CustomVector<int32_t> copy(4,2); copy = vector; CustomVector<int32_t> moved = std::move(copy); vector = std::move(moved);}
+                else if(operation<76) {std::swap(vector,other); std::swap(model,other_model);}
+                CHECK(vector.size()==model.size());
+            }
+            for(size_t i = 0; i<model.size(); i++) CHECK(vector[i]==model[i]);
+            for(size_t i = 0; i<other_model.size(); i++) CHECK(other[i]==other_model[i]);
+        }
+        arena.reset();
+    }
+    return 0;
+}
+
+static void empty_callback(void* user_data,SDL_Event* event,cSDL_ButtonsManager* class_obj)
+{
+    (void)user_data; (void)event; (void)class_obj;
+    return;
+}
+
+// manager made on heap gets new buttons/events inside of scope (its maps of ids are rehashed and indexes are rebuilt there);
+static int32_t test_manager_in_scope()
+{
+    cSDL_ButtonsManager* manager = new cSDL_ButtonsManager();
+    manager->enable_spatial_index(1,0);
+    CountingAllocator allocator;
+    std::vector<uint32_t> button_ids;
+    {
+        CustomVectorAllocatorScope scope(&allocator);
+        for(int32_t i = 0; i<3000; i++)
+        {
+            SDL_Rect rect = {(i%60)*20,(i/60)*20,18,18};
+            button_ids.push_back(manager->create_button(rect,1,i));
+            manager->create_event(empty_callback,NULL);
+        }
+        for(int32_t i = 0; i<3000; i+=3) manager->delete_buttons(button_ids[i]);
+
+        SDL_Event event;
+        memset(&event,0,sizeof(event));
+        event.type = SDL_MOUSEMOTION;
+        event.motion.x = 25; event.motion.y = 25;
+        manager->set_manually_focus_device(cSDL_ButtonsManager::MOUSE);
+        manager->run_event_checker(&event);
+    }
+    CHECK(allocator.live_allocations==0);
+    for(int32_t i = 0; i<3000; i++)
+    {
+        const size_t expected = (i%3==0) ? 0xFFFFFFFF : (size_t)(i-i/3-1);
+        CHECK(manager->get_button_index(button_ids[i])==expected);
+    }
+    delete manager;
+    return 0;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    if(test_arena_alignment()!=0) return 1;
+    if(test_heap_containers_in_scope()!=0) return 1;
+    if(test_scope_containers_outside()!=0) return 1;
+    if(test_manager_in_scope()!=0) return 1;
+    for(uint32_t seed = 1; seed<=3; seed++)
+    {
+        if(test_vectors_in_arena(seed)!=0) return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
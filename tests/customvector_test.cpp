@@ -0,0 +1,143 @@
+// randomized test of CustomVector against std::vector; the same operations are done on both and their elements are compared;
+//      growth (push_back/reserve/shrink_to_fit/copy/move) and bulk functions (emplace_back/append/resize/insert/erase) are tested separately;
+//      int and 16-bytes struct go through realloc() path (trivially copyable) and std::string through operator new + move of every element;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/customvector_test.cpp -o customvector_test && ./customvector_test
+//      (add "-fsanitize=address,undefined" to check memory too and "-DCUSTOMVECTOR_NO_REALLOC" to test the path without realloc());
+
+#include "_s2t_tools.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+
+struct Rect16
+{
+    int32_t x; int32_t y; int32_t w; int32_t h;
+    bool operator==(const Rect16& other) const {return x==other.x&&y==other.y&&w==other.w&&h==other.h;}
+};
+
+static int32_t random_int() {return rand();}
+static Rect16 random_rect() {Rect16 rect = {rand(),rand(),rand(),rand()}; return rect;}
+static std::string random_string() {return std::string(rand()%40,(char)('a'+rand()%26));}
+
+template <typename T> static bool equal(const CustomVector<T>& vector,const std::vector<T>& model)
+{
+    if(vector.size()!=model.size()) return 0;
+    for(size_t i = 0; i<model.size(); i++) if(!(vector[i]==model[i])) return 0;
+    return 1;
+}
+
+// push_back/pop_back/reserve/shrink_to_fit/clear/copy/move;
+template <typename T> static int32_t run_growth(T (*random_value)(),uint32_t seed)
+{
+    srand(seed);
+    CustomVector<T> vector(4,2);
+    std::vector<T> model;
+    for(int32_t q = 0; q<60000; q++)
+    {
+        const int32_t operation = rand()%100;
+        if(operation<60) {const T value = random_value(); vector.push_back(value); model.push_back(value);}
+        else if(operation<65) {if(model.size()!=0) {vector.pop_back(); model.pop_back();}}
+        else if(operation<67) vector.reserve(rand()%400000);
+        else if(operation<69) vector.shrink_to_fit();
+        else if(operation<70) {vector.clear(); model.clear();}
+        else if(operation<72) {CustomVector<T> copy = vector; vector = copy;}
+        else if(operation<74) {CustomVector<T> copy(4,2); copy = vector; CustomVector<T> moved = std::move(copy); vector = std::move(moved);}
+        else if(operation<76&&model.size()!=0) {const size_t i = rand()%model.size(); const T value = random_value(); vector[i] = value; model[i] = value;}
+
+        if(vector.size()!=model.size()||(q%1000==0&&equal(vector,model)==0))
+        {
+            printf("growth seed %u step %d: vector differs from std::vector\n",seed,q);
+            return -1;
+        }
+    }
+    if(equal(vector,model)==0)
+    {
+        printf("growth seed %u: vector differs from std::vector at the end\n",seed);
+        return -1;
+    }
+    return 0;
+}
+
+// emplace_back/append/resize/insert/erase; also with element of the same vector as argument (it can be moved by growth);
+template <typename T> static int32_t run_bulk(T (*random_value)(),uint32_t seed)
+{
+    srand(seed);
+    CustomVector<T> vector(4,2);
+    std::vector<T> model;
+    for(int32_t q = 0; q<50000; q++)
+    {
+        const int32_t operation = rand()%12;
+        if(operation==0) {const T value = random_value(); vector.emplace_back(value); model.emplace_back(value);}
+        else if(operation==1)
+        {
+            T values[7]; const size_t count = rand()%7;
+            for(size_t i = 0; i<count; i++) values[i] = random_value();
+            vector.append(values,count); model.insert(model.end(),values,values+count);
+        }
+        else if(operation==2) {const size_t size = rand()%(model.size()+5); vector.resize(size); model.resize(size);}
+        else if(operation==3) {const size_t size = rand()%(model.size()+5); const T value = random_value(); vector.resize(size,value); model.resize(size,value);}
+        else if(operation==4)
+        {
+            const size_t position = rand()%(model.size()+3); const T value = random_value();    // position past the end adds at the end;
+            vector.insert(position,value); model.insert(model.begin()+((position<model.size()) ? position : model.size()),value);
+        }
+        else if(operation==5)
+        {
+            const size_t position = rand()%(model.size()+3);
+            T values[5]; const size_t count = rand()%5;
+            for(size_t i = 0; i<count; i++) values[i] = random_value();
+            vector.insert(position,values,count); model.insert(model.begin()+((position<model.size()) ? position : model.size()),values,values+count);
+        }
+        else if(operation==6&&model.size()!=0)
+        {
+            const size_t position = rand()%(model.size()+3),from = rand()%model.size();
+            const T value = model[from];
+            vector.insert(position,vector[from]); model.insert(model.begin()+((position<model.size()) ? position : model.size()),value);
+        }
+        else if(operation==7&&model.size()!=0)
+        {
+            const size_t size = rand()%(model.size()+5),from = rand()%model.size();
+            const T value = model[from];
+            vector.resize(size,vector[from]); model.resize(size,value);
+        }
+        else if(operation==8&&model.size()>50) {vector.erase(0,40); model.erase(model.begin(),model.begin()+41);}
+        else if(operation==9) {vector.clear(); model.clear();}
+        else {const T value = random_value(); vector.push_back(value); model.push_back(value);}
+
+        if(equal(vector,model)==0)
+        {
+            printf("bulk seed %u step %d operation %d: vector differs from std::vector\n",seed,q,operation);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    for(uint32_t seed = 1; seed<=4; seed++)
+    {
+        if(run_growth<int32_t>(random_int,seed)!=0) return 1;
+        if(run_growth<Rect16>(random_rect,seed)!=0) return 1;
+        if(run_growth<std::string>(random_string,seed)!=0) return 1;
+        if(run_bulk<int32_t>(random_int,seed)!=0) return 1;
+        if(run_bulk<Rect16>(random_rect,seed)!=0) return 1;
+        if(run_bulk<std::string>(random_string,seed)!=0) return 1;
+    }
+
+    // only for trivially copyable types; elements written after growth are kept by shrinking;
+    CustomVector<int32_t> uninitialized;
+    uninitialized.resize_uninitialized(100);
+    for(int32_t i = 0; i<100; i++) uninitialized[i] = i;
+    uninitialized.resize_uninitialized(10);
+    if(uninitialized.size()!=10||uninitialized[9]!=9)
+    {
+        printf("resize_uninitialized: wrong size or elements\n");
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+// randomized test of "cSDL_TicksConverter::convert()" and of "cSDL_ticks_to_*()"/"cSDL_*_to_ticks()" functions;
+//      ~2M random ticks (and some border values) are converted to ns/us/ms at frequencies from 1GHz to 1Hz and every result is checked
+//          to be exact "floor(ticks*unit/frequency)" with 128-bit products made from 32-bit parts (so the check doesn't use code that is tested);
+//      free functions are checked only at frequency of SDL performance counter;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/ticks_converter_test.cpp -o ticks_converter_test `sdl2-config --cflags --libs` -lSDL2_image && ./ticks_converter_test
+//      (add "-DCSDL_TICKS_NO_INT128" to test division used without 128-bit integers; add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "sdl2_tools.h"
+#include <stdio.h>
+
+static Uint64 random_state = 0x9E3779B97F4A7C15ull;
+
+// xorshift64; rand() gives only 15-31 bits;
+static Uint64 random64()
+{
+    random_state ^= random_state<<13;
+    random_state ^= random_state>>7;
+    random_state ^= random_state<<17;
+    return random_state;
+}
+
+// "a*b" as 128-bit number "high*2^64+low";
+static void multiply_64x64(Uint64 a,Uint64 b,Uint64* high,Uint64* low)
+{
+    const Uint64 a_low = a&0xFFFFFFFF,a_high = a>>32;
+    const Uint64 b_low = b&0xFFFFFFFF,b_high = b>>32;
+    const Uint64 low_low = a_low*b_low;
+    const Uint64 high_low = a_high*b_low;
+    const Uint64 low_high = a_low*b_high;
+    const Uint64 middle = (low_low>>32)+(high_low&0xFFFFFFFF)+(low_high&0xFFFFFFFF);
+    *low = (middle<<32)|(low_low&0xFFFFFFFF);
+    *high = a_high*b_high+(high_low>>32)+(low_high>>32)+(middle>>32);
+    return;
+}
+
+// true if "result" == floor(value*to/from); so "result*from <= value*to" and "value*to-result*from < from";
+static bool is_exact(Uint64 value,Uint64 to,Uint64 from,Uint64 result)
+{
+    Uint64 exact_high,exact_low,result_high,result_low;
+    multiply_64x64(value,to,&exact_high,&exact_low);
+    multiply_64x64(result,from,&result_high,&result_low);
+    if(result_high>exact_high||(result_high==exact_high&&result_low>exact_low)) return 0;
+    const Uint64 borrow = (exact_low<result_low) ? 1 : 0;
+    if(exact_high-result_high-borrow!=0) return 0;
+    return (exact_low-result_low<from);
+}
+
+// the highest value that can be converted from "from" to "to" units without overflow of 64-bit result;
+static Uint64 max_value(Uint64 to,Uint64 from)
+{
+    if(to<=from) return 0xFFFFFFFFFFFFFFFFull;
+    return (0xFFFFFFFFFFFFFFFFull/to)*from;
+}
+
+// random value with random number of bits so small values are tested as often as big ones;
+static Uint64 random_value(Uint64 max)
+{
+    Uint64 value = random64()>>(random64()%64);
+    if(max!=0xFFFFFFFFFFFFFFFFull) value %= max+1;
+    return value;
+}
+
+static int32_t errors = 0;
+
+static void report(const char* name,Uint64 frequency,Uint64 unit,Uint64 value,Uint64 result)
+{
+    if(errors<10) printf("%s: frequency %llu unit %llu value %llu gives %llu\n",name,(unsigned long long)frequency,(unsigned long long)unit,
+                         (unsigned long long)value,(unsigned long long)result);
+    errors++;
+    return;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    const Uint64 frequencies[9] = {1000000000,24000000,19200000,10000000,3579545,32768,1000,7,1};
+    const Uint64 units[3] = {1000000000,1000000,1000};
+    const uint32_t random_values = 75000;     // 9*3*75000 ~= 2M;
+
+    for(uint32_t f = 0; f<9; f++)
+    {
+        for(uint32_t u = 0; u<3; u++)
+        {
+            const Uint64 frequency = frequencies[f],unit = units[u];
+            const cSDL_TicksConverter converter(unit,frequency);
+            const Uint64 max = max_value(unit,frequency);
+            const Uint64 borders[8] = {0,1,frequency-1,frequency,frequency+1,max/2,max-1,max};
+            for(uint32_t i = 0; i<8+random_values; i++)
+            {
+                const Uint64 ticks = (i<8) ? borders[i] : random_value(max);
+                const Uint64 result = converter.convert(ticks);
+                if(is_exact(ticks,unit,frequency,result)==0) report("convert",frequency,unit,ticks,result);
+            }
+        }
+    }
+
+    SDL_Init(SDL_INIT_TIMER);
+    const Uint64 frequency = cSDL_ticks_frequency();
+    for(uint32_t i = 0; i<100000; i++)
+    {
+        const Uint64 ticks = random_value(max_value(1000000000,frequency));
+        if(is_exact(ticks,1000000000,frequency,cSDL_ticks_to_nanoseconds(ticks))==0) report("cSDL_ticks_to_nanoseconds",frequency,1000000000,ticks,cSDL_ticks_to_nanoseconds(ticks));
+        if(is_exact(ticks,1000000,frequency,cSDL_ticks_to_microseconds(ticks))==0) report("cSDL_ticks_to_microseconds",frequency,1000000,ticks,cSDL_ticks_to_microseconds(ticks));
+        if(is_exact(ticks,1000,frequency,cSDL_ticks_to_milliseconds(ticks))==0) report("cSDL_ticks_to_milliseconds",frequency,1000,ticks,cSDL_ticks_to_milliseconds(ticks));
+
+        const Uint64 nanoseconds = random_value(max_value(frequency,1000000000));
+        const Uint64 microseconds = random_value(max_value(frequency,1000000));
+        const Uint64 miliseconds = random_value(max_value(frequency,1000));
+        if(is_exact(nanoseconds,frequency,1000000000,cSDL_nanoseconds_to_ticks(nanoseconds))==0) report("cSDL_nanoseconds_to_ticks",frequency,1000000000,nanoseconds,cSDL_nanoseconds_to_ticks(nanoseconds));
+        if(is_exact(microseconds,frequency,1000000,cSDL_microseconds_to_ticks(microseconds))==0) report("cSDL_microseconds_to_ticks",frequency,1000000,microseconds,cSDL_microseconds_to_ticks(microseconds));
+        if(is_exact(miliseconds,frequency,1000,cSDL_milliseconds_to_ticks(miliseconds))==0) report("cSDL_milliseconds_to_ticks",frequency,1000,miliseconds,cSDL_milliseconds_to_ticks(miliseconds));
+    }
+    SDL_Quit();
+
+    if(errors!=0)
+    {
+        printf("%d errors\n",errors);
+        return 1;
+    }
+#if defined(CSDL_TICKS_USE_INT128)
+    printf("ok (128-bit multiplication)\n");
+#else
+    printf("ok (division)\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,253 @@
+// test of "cSDL_TimerScheduler" with fake performance counter (time is changed only by the test so results are always the same);
+//      periodic timers are compared with "cSDL_MicroTimer" on the same time (the same number of ends with carried rest of time);
+//      one-shot timers have to end once and be removed;
+//      random create/delete/reset/change of delay/run are compared with simple model of timers; if "id" -> index in heap isn't kept in sync
+//          then operations by "id" change wrong timers and results of "run_timers()" differ from model;
+// build and run (from main directory of repository); returns 0 and prints "ok" if every check passed:
+//      g++ -O2 -std=c++11 -I. tests/timer_scheduler_test.cpp -o timer_scheduler_test `sdl2-config --cflags --libs` -lSDL2_image && ./timer_scheduler_test
+//      (add "-fsanitize=address,undefined" to check memory too);
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+// functions of SDL used by "sdl2_tools.h" to read time are replaced by fake counter with 10 ticks per microsecond;
+static Uint64 fake_ticks = 0;
+static Uint64 fake_performance_counter(){return fake_ticks;}
+static Uint64 fake_performance_frequency(){return 10000000;}
+#define SDL_GetPerformanceCounter fake_performance_counter
+#define SDL_GetPerformanceFrequency fake_performance_frequency
+#include "sdl2_tools.h"
+
+static int32_t errors = 0;
+
+#define CHECK(condition) do{ if(!(condition)){ if(errors<10) printf("line %d: %s\n",__LINE__,#condition); errors++; } }while(0)
+
+static void set_time(uint64_t microseconds)
+{
+    fake_ticks = microseconds*10;
+    return;
+}
+
+// returns "count" of timer with "id" in result of "run_timers()" (0 if it didn't end);
+static uint64_t expired_count(const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& expired,uint32_t id)
+{
+    for(size_t i = 0; i<expired.size(); i++) if(expired[i].id==id) return expired[i].count;
+    return 0;
+}
+
+static void test_periodic_timer()
+{
+    set_time(1000000);
+    cSDL_TimerScheduler scheduler;
+    cSDL_MicroTimer micro_timer;
+    const uint32_t id = scheduler.create_timer(1000,7);
+    micro_timer.set_internal_timer(1000);
+
+    // 2.5 delays: 2 ends and 500us is carried; then 0.6 delay more ends once more (500+600 >= 1000);
+    set_time(1002500);
+    const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& expired = scheduler.run_timers();
+    CHECK(expired.size()==1&&expired[0].id==id&&expired[0].user_custom_data==7&&expired[0].count==2);
+    CHECK(micro_timer.run_timer()==2);
+    set_time(1003100);
+    CHECK(expired_count(scheduler.run_timers(),id)==1);
+    CHECK(micro_timer.run_timer()==1);
+    set_time(1003999);
+    CHECK(scheduler.run_timers().size()==0);
+    CHECK(scheduler.get_time_to_next_timer()==1);
+    CHECK(micro_timer.run_timer()==0);
+    set_time(1004000);
+    CHECK(expired_count(scheduler.run_timers(),id)==1);
+    CHECK(micro_timer.run_timer()==1);
+
+    // random steps (also not whole microseconds) have to give the same ends as "cSDL_MicroTimer";
+    srand(1);
+    uint64_t scheduler_sum = 0,micro_timer_sum = 0;
+    for(uint32_t i = 0; i<100000; i++)
+    {
+        fake_ticks += (Uint64)(rand()%40000);
+        const uint64_t scheduler_count = expired_count(scheduler.run_timers(),id);
+        const uint64_t micro_timer_count = micro_timer.run_timer();
+        CHECK(scheduler_count==micro_timer_count);
+        scheduler_sum += scheduler_count;
+        micro_timer_sum += micro_timer_count;
+    }
+    CHECK(scheduler_sum==micro_timer_sum);
+    CHECK(scheduler.get_timers_count()==1);
+    return;
+}
+
+static void test_one_shot_timer()
+{
+    set_time(5000000);
+    cSDL_TimerScheduler scheduler;
+    const uint32_t periodic = scheduler.create_timer(300);
+    const uint32_t one_shot = scheduler.create_one_shot_timer(1000,3);
+    CHECK(scheduler.create_one_shot_timer(0)==0);
+    CHECK(scheduler.get_timers_count()==2);
+
+    set_time(5000999);
+    CHECK(expired_count(scheduler.run_timers(),one_shot)==0);
+
+    // one-shot timer ends once even if a lot of its delays passed;
+    set_time(5010000);
+    const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& expired = scheduler.run_timers();
+    CHECK(expired.size()==2);
+    CHECK(expired_count(expired,one_shot)==1);
+    CHECK(expired_count(expired,periodic)==30);    // 3 ends were already returned at 5000999;
+    CHECK(scheduler.get_timers_count()==1);
+
+    // operations on removed one-shot timer do nothing;
+    scheduler.reset_timer(one_shot);
+    scheduler.change_timer_delay(one_shot,10);
+    scheduler.delete_timer(one_shot);
+    CHECK(scheduler.get_timers_count()==1);
+    set_time(5100000);
+    CHECK(expired_count(scheduler.run_timers(),periodic)==300);
+    CHECK(expired.size()==1);
+
+    scheduler.clear();
+    CHECK(scheduler.get_timers_count()==0);
+    CHECK(scheduler.get_time_to_next_timer()==0xFFFFFFFFFFFFFFFFull);
+    return;
+}
+
+struct ModelTimer
+{
+    uint32_t id;
+    uint64_t deadline;
+    uint64_t delay;
+    bool one_shot;
+};
+
+static size_t find_in_model(const std::vector<ModelTimer>& timers,uint32_t id)
+{
+    for(size_t i = 0; i<timers.size(); i++) if(timers[i].id==id) return i;
+    return 0xFFFFFFFF;
+}
+
+static bool expired_less(const cSDL_TimerScheduler::ExpiredTimer& a,const cSDL_TimerScheduler::ExpiredTimer& b)
+{
+    return a.id<b.id;
+}
+
+static void test_random_operations(uint32_t seed)
+{
+    srand(seed);
+    uint64_t now = 1000000;
+    set_time(now);
+    cSDL_TimerScheduler scheduler;
+    std::vector<ModelTimer> timers;
+    std::vector<uint32_t> removed_ids;
+
+    for(uint32_t step = 0; step<5000; step++)
+    {
+        const int32_t operation = rand()%100;
+        if(operation<25||timers.size()<4)
+        {
+            ModelTimer timer;
+            timer.delay = 1+(uint64_t)(rand()%5000);
+            timer.deadline = now+timer.delay;
+            timer.one_shot = (rand()%4==0);
+            timer.id = (timer.one_shot==1) ? scheduler.create_one_shot_timer(timer.delay,step) : scheduler.create_timer(timer.delay,step);
+            CHECK(timer.id!=0&&find_in_model(timers,timer.id)==0xFFFFFFFF);
+            timers.push_back(timer);
+        }
+        else if(operation<40)
+        {
+            const size_t index = (size_t)rand()%timers.size();
+            scheduler.delete_timer(timers[index].id);
+            removed_ids.push_back(timers[index].id);
+            timers.erase(timers.begin()+index);
+        }
+        else if(operation<50)
+        {
+            const size_t index = (size_t)rand()%timers.size();
+            scheduler.reset_timer(timers[index].id);
+            timers[index].deadline = now+timers[index].delay;
+        }
+        else if(operation<60)
+        {
+            const size_t index = (size_t)rand()%timers.size();
+            const uint64_t delay = 1+(uint64_t)(rand()%5000);
+            scheduler.change_timer_delay(timers[index].id,delay);
+            timers[index].delay = delay;
+            timers[index].deadline = now+delay;
+        }
+        else if(operation<65&&removed_ids.size()!=0)
+        {
+            // deleted "id" mustn't change any timer;
+            const uint32_t id = removed_ids[(size_t)rand()%removed_ids.size()];
+            scheduler.delete_timer(id);
+            scheduler.reset_timer(id);
+            scheduler.change_timer_delay(id,1);
+        }
+        else
+        {
+            now += (uint64_t)(rand()%3000);
+            set_time(now);
+            const CustomVector<cSDL_TimerScheduler::ExpiredTimer>& expired = scheduler.run_timers();
+
+            // timers are returned by their deadlines;
+            std::vector<uint64_t> deadlines;
+            for(size_t i = 0; i<expired.size(); i++)
+            {
+                const size_t index = find_in_model(timers,expired[i].id);
+                CHECK(index!=0xFFFFFFFF);
+                if(index!=0xFFFFFFFF) deadlines.push_back(timers[index].deadline);
+            }
+            CHECK(std::is_sorted(deadlines.begin(),deadlines.end()));
+
+            std::vector<cSDL_TimerScheduler::ExpiredTimer> model_expired;
+            for(size_t i = 0; i<timers.size(); i++)
+            {
+                if(timers[i].deadline>now) continue;
+                cSDL_TimerScheduler::ExpiredTimer timer;
+                timer.id = timers[i].id;
+                timer.user_custom_data = 0;
+                timer.count = (timers[i].one_shot==1) ? 1 : (now-timers[i].deadline)/timers[i].delay+1;
+                if(timers[i].one_shot==0) timers[i].deadline += timer.count*timers[i].delay;   // ended one-shot timers are removed below;
+                model_expired.push_back(timer);
+            }
+            for(size_t i = 0; i<timers.size(); i++)
+            {
+                if(timers[i].one_shot==0||timers[i].deadline>now) continue;
+                removed_ids.push_back(timers[i].id);
+                timers.erase(timers.begin()+i);
+                i--;
+            }
+
+            std::vector<cSDL_TimerScheduler::ExpiredTimer> sorted_expired(expired.begin(),expired.end());
+            std::sort(sorted_expired.begin(),sorted_expired.end(),expired_less);
+            std::sort(model_expired.begin(),model_expired.end(),expired_less);
+            CHECK(sorted_expired.size()==model_expired.size());
+            for(size_t i = 0; i<sorted_expired.size()&&i<model_expired.size(); i++)
+                CHECK(sorted_expired[i].id==model_expired[i].id&&sorted_expired[i].count==model_expired[i].count);
+        }
+
+        CHECK(scheduler.get_timers_count()==timers.size());
+        uint64_t nearest = 0xFFFFFFFFFFFFFFFFull;
+        for(size_t i = 0; i<timers.size(); i++) if(timers[i].deadline<nearest) nearest = timers[i].deadline;
+        CHECK(scheduler.get_time_to_next_timer()==((nearest==0xFFFFFFFFFFFFFFFFull) ? nearest : ((nearest<=now) ? 0 : nearest-now)));
+    }
+    return;
+}
+
+int main(int argc,char** argv)
+{
+    (void)argc; (void)argv;
+    test_periodic_timer();
+    test_one_shot_timer();
+    for(uint32_t seed = 1; seed<=20; seed++) test_random_operations(seed);
+
+    if(errors!=0)
+    {
+        printf("%d errors\n",errors);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}